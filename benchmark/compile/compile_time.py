@@ -0,0 +1,102 @@
+"""Measures compile time and peak compiler memory of static_bindings.cpp.
+
+Each binding count is compiled as a separate translation unit and the wall
+time together with the peak resident set size of the compiler is reported.
+Results can be written as JSON to track them across changes.
+"""
+
+import argparse
+import json
+import os
+from pathlib import Path
+import resource
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+
+SOURCE = Path(__file__).resolve().parent / "static_bindings.cpp"
+
+
+def peak_rss_bytes(usage):
+    # ru_maxrss is reported in bytes on macOS and in kilobytes elsewhere.
+    if sys.platform == "darwin":
+        return usage.ru_maxrss
+    return usage.ru_maxrss * 1024
+
+
+def compile_once(compiler, flags, bindings, output):
+    command = [
+        *compiler,
+        *flags,
+        "-DDINGO_COMPILE_BENCHMARK_BINDINGS={}".format(bindings),
+        "-c",
+        str(SOURCE),
+        "-o",
+        str(output),
+    ]
+
+    start = time.perf_counter()
+    process = subprocess.Popen(command)
+    _, status, usage = os.wait4(process.pid, 0)
+    elapsed = time.perf_counter() - start
+    # Popen would otherwise try to reap the already collected child.
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        raise Exception(
+            "compilation failed with {}: {}".format(
+                process.returncode, shlex.join(command)
+            )
+        )
+
+    return elapsed, peak_rss_bytes(usage)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--compiler", required=True)
+    parser.add_argument("--include", action="append", default=[])
+    parser.add_argument("--flags", default="")
+    parser.add_argument(
+        "--bindings", type=int, nargs="+", default=[100, 500, 1000]
+    )
+    parser.add_argument("--repetitions", type=int, default=1)
+    parser.add_argument("--json", type=Path)
+    args = parser.parse_args()
+
+    compiler = shlex.split(args.compiler)
+    flags = ["-I{}".format(path) for path in args.include]
+    flags.extend(shlex.split(args.flags))
+
+    results = []
+    with tempfile.TemporaryDirectory() as directory:
+        output = Path(directory) / "static_bindings.o"
+        for bindings in args.bindings:
+            # The fastest run is the least disturbed by the rest of the system.
+            samples = [
+                compile_once(compiler, flags, bindings, output)
+                for _ in range(args.repetitions)
+            ]
+            elapsed = min(sample[0] for sample in samples)
+            memory = max(sample[1] for sample in samples)
+            results.append(
+                {
+                    "bindings": bindings,
+                    "seconds": round(elapsed, 3),
+                    "peak_memory_mb": round(memory / (1024 * 1024), 1),
+                }
+            )
+            print(
+                "{:>6} bindings {:>9.3f} s {:>9.1f} MB".format(
+                    bindings, elapsed, memory / (1024 * 1024)
+                ),
+                flush=True,
+            )
+
+    if args.json:
+        args.json.write_text(json.dumps(results, indent=2) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+// Translation unit measured by compile_time.py. It registers
+// DINGO_COMPILE_BENCHMARK_BINDINGS services in one static_container and
+// resolves each of them, so lookup, dependency checks and activation planning
+// all scale with the binding count. Services form a binary tree so the
+// dependency depth stays logarithmic.
+
+#include <dingo/static_container.h>
+#include <dingo/storage/shared.h>
+
+#include <cstddef>
+#include <utility>
+
+#ifndef DINGO_COMPILE_BENCHMARK_BINDINGS
+#define DINGO_COMPILE_BENCHMARK_BINDINGS 100
+#endif
+
+namespace {
+constexpr size_t binding_count = DINGO_COMPILE_BENCHMARK_BINDINGS;
+static_assert(binding_count > 0);
+
+template <size_t Index> struct service;
+
+template <> struct service<0> {
+  size_t id() const { return 0; }
+};
+
+template <size_t Index> struct service {
+  explicit service(service<Index / 2> &) {}
+  size_t id() const { return Index; }
+};
+
+template <size_t Index>
+using service_binding =
+    dingo::bind<dingo::scope<dingo::shared>, dingo::storage<service<Index>>>;
+
+template <typename Indexes> struct service_bindings;
+
+template <size_t... Indexes>
+struct service_bindings<std::index_sequence<Indexes...>> {
+  using type = dingo::bindings<service_binding<Indexes>...>;
+
+  template <typename Container>
+  static size_t resolve_all(Container &container) {
+    return (size_t{0} + ... +
+            container.template resolve<service<Indexes> &>().id());
+  }
+};
+
+using services = service_bindings<std::make_index_sequence<binding_count>>;
+using source = typename services::type;
+} // namespace
+
+int main() {
+  dingo::static_container<source> container;
+  return services::resolve_all(container) ==
+                 binding_count * (binding_count - 1) / 2
+             ? 0
+             : 1;
+}
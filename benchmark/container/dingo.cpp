@@ -7,8 +7,10 @@
 
 #include <dingo/container.h>
 #include <dingo/memory/arena_allocator.h>
+#include <dingo/rtti/interned_provider.h>
 #include <dingo/runtime/container_runtime.h>
 #include <dingo/runtime/context.h>
+#include <dingo/runtime/session.h>
 #include <dingo/storage/external.h>
 #include <dingo/storage/shared.h>
 #include <dingo/storage/unique.h>
@@ -18,6 +20,10 @@
 #include <array>
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 BENCHMARK_MAIN();
@@ -32,10 +38,29 @@ template <size_t = 0> struct Class : IClass {};
 
 struct cold_leaf {};
 
+struct dense_container_traits : dingo::dynamic_container_traits {
+  using rtti_type = dingo::rtti<dingo::interned_provider>;
+  using lookup_definition_type =
+      dingo::lookups<dingo::base<dingo::one, dingo::dense>>;
+};
+
+struct collection_container_traits : dingo::dynamic_container_traits {
+  using lookup_definition_type = dingo::lookups<dingo::collection<IClass>>;
+};
+
 struct cold_service {
   explicit cold_service(cold_leaf &) {}
 };
 
+struct keyed_container_traits : dingo::dynamic_container_traits {
+  using lookup_definition_type =
+      dingo::lookups<dingo::associative<int, IClass>>;
+};
+
+struct fixed_arena_container_traits : keyed_container_traits {
+  using arena_growth_type = dingo::arena_growth<DINGO_RUNTIME_ARENA_BLOCK_SIZE>;
+};
+
 struct transaction_fixture {
   using allocator_type = std::allocator<char>;
 
@@ -98,6 +123,23 @@ static void resolve_container_shared(benchmark::State &state) {
   state.SetBytesProcessed(state.iterations());
 }
 
+template <typename ContainerTraits>
+static void resolve_container_shared_handle(benchmark::State &state) {
+  using namespace dingo;
+  using container_type = container<ContainerTraits>;
+  container_type container;
+  container.template register_type<scope<shared>, storage<int>>();
+  auto handle = container.template handle<int &>();
+
+  size_t count = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(handle);
+    count += is_empty(handle.get());
+  }
+  benchmark::DoNotOptimize(count);
+  state.SetBytesProcessed(state.iterations());
+}
+
 template <typename ContainerTraits>
 static void resolve_container_shared_ptr(benchmark::State &state) {
   using namespace dingo;
@@ -313,6 +355,86 @@ static void resolve_container_cold_dependency(benchmark::State &state) {
       });
 }
 
+// A unique-scope chain whose temporaries outgrow the inline resolution
+// buffer, so every resolve needs scratch blocks beyond it.
+template <size_t Depth> struct deep_unique {
+  explicit deep_unique(const deep_unique<Depth - 1> &) {}
+  char payload[64] = {};
+};
+
+template <> struct deep_unique<0> {
+  deep_unique() {}
+  char payload[64] = {};
+};
+
+template <size_t... Depths>
+static void register_deep_unique(dingo::container<> &container,
+                                 std::index_sequence<Depths...>) {
+  using namespace dingo;
+  (container.template register_type<scope<unique>,
+                                    storage<deep_unique<Depths>>>(),
+   ...);
+}
+
+template <bool UseSession>
+static void resolve_container_deep_unique(benchmark::State &state) {
+  constexpr size_t depth = 16;
+  dingo::container<> container;
+  register_deep_unique(container, std::make_index_sequence<depth + 1>());
+  std::optional<dingo::resolution_session> session;
+  if constexpr (UseSession) {
+    session.emplace();
+  }
+
+  size_t count = 0;
+  for (auto _ : state) {
+    count += container.resolve<deep_unique<depth>>().payload[0] == 0;
+  }
+  benchmark::DoNotOptimize(count);
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <size_t... Indices>
+static void register_batch(dingo::container<> &container,
+                           std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<scope<shared>, storage<Class<Indices>>>(),
+   ...);
+}
+
+template <size_t... Indices>
+static size_t resolve_batch_separately(dingo::container<> &container,
+                                       std::index_sequence<Indices...>) {
+  return (size_t(container.resolve<Class<Indices> *>() != nullptr) + ...);
+}
+
+template <size_t... Indices>
+static size_t resolve_batch_together(dingo::container<> &container,
+                                     std::index_sequence<Indices...>) {
+  auto result = container.resolve_all<Class<Indices> *...>();
+  return (size_t(std::get<Indices>(result) != nullptr) + ...);
+}
+
+// Ten shared requests resolved one by one or as a single resolve_all batch,
+// which pays for one resolution context and transaction instead of ten.
+template <bool Batched>
+static void resolve_container_batch(benchmark::State &state) {
+  constexpr auto indices = std::make_index_sequence<10>();
+  dingo::container<> container;
+  register_batch(container, indices);
+
+  size_t count = 0;
+  for (auto _ : state) {
+    if constexpr (Batched) {
+      count += resolve_batch_together(container, indices);
+    } else {
+      count += resolve_batch_separately(container, indices);
+    }
+  }
+  benchmark::DoNotOptimize(count);
+  state.SetItemsProcessed(state.iterations() * 10);
+}
+
 template <typename Container>
 static void register_type(benchmark::State &state) {
   using namespace dingo;
@@ -381,6 +503,129 @@ static void register_type_arena_10(benchmark::State &state) {
   state.SetBytesProcessed(state.iterations() * 10);
 }
 
+// Registers state.range(0) keyed bindings, with the arena blocks fixed at
+// DINGO_RUNTIME_ARENA_BLOCK_SIZE, growing, or reserved up front.
+template <typename ContainerTraits, bool Reserve>
+static void register_type_many(benchmark::State &state) {
+  using namespace dingo;
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    container<ContainerTraits> container;
+    if constexpr (Reserve) {
+      container.reserve_bindings(static_cast<std::size_t>(count));
+    }
+    for (int key = 0; key != count; ++key) {
+      container.template register_type<scope<unique>, storage<Class<0>>,
+                                       interfaces<IClass>>(key_value{key});
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Resolves state.range(0) keyed shared bindings in turn, with the lookup left
+// in its ordered backend or frozen into a sorted table.
+template <bool Freeze>
+static void resolve_container_keyed(benchmark::State &state) {
+  using namespace dingo;
+  const auto count = static_cast<int>(state.range(0));
+  container<keyed_container_traits> container;
+  for (int key = 0; key != count; ++key) {
+    container.template register_type<scope<shared>, storage<Class<0>>,
+                                     interfaces<IClass>>(key_value{key});
+  }
+  if constexpr (Freeze) {
+    container.freeze();
+  }
+
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&container.template resolve<IClass &>(key));
+    key = key + 1 != count ? key + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container, size_t... Indices>
+static void register_collection_members(Container &container,
+                                        std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<scope<unique>,
+                                    storage<std::unique_ptr<Class<Indices>>>,
+                                    interfaces<IClass>>(),
+   ...);
+}
+
+// A consumer that stops at the first member of a 16 member collection of
+// unique instances: the vector constructs all of them, the lazy collection
+// only the one it dereferences.
+template <bool Lazy>
+static void resolve_container_collection_first(benchmark::State &state) {
+  using namespace dingo;
+  container<collection_container_traits> container;
+  register_collection_members(container, std::make_index_sequence<16>());
+
+  for (auto _ : state) {
+    if constexpr (Lazy) {
+      using collection_type = lazy_collection<std::unique_ptr<IClass>>;
+      auto members = container.template resolve<collection_type>();
+      benchmark::DoNotOptimize(*members.begin());
+    } else {
+      auto members =
+          container.template resolve<std::vector<std::unique_ptr<IClass>>>();
+      benchmark::DoNotOptimize(members.front());
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Members whose constructors take about 50us each. The parallel variant runs
+// each constructor on its own thread.
+template <size_t> struct ExpensiveClass : IClass {
+  ExpensiveClass() {
+    const auto until =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(50);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+  }
+};
+
+template <typename Container, size_t... Indices>
+static void register_expensive_members(Container &container,
+                                       std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<
+       scope<unique>, storage<std::unique_ptr<ExpensiveClass<Indices>>>,
+       interfaces<IClass>>(),
+   ...);
+}
+
+template <bool Parallel>
+static void construct_container_collection_parallel(benchmark::State &state) {
+  using namespace dingo;
+  using collection_type = std::vector<std::unique_ptr<IClass>>;
+  container<collection_container_traits> container;
+  register_expensive_members(container, std::make_index_sequence<8>());
+
+  for (auto _ : state) {
+    if constexpr (Parallel) {
+      std::vector<std::thread> threads;
+      auto members =
+          container.template construct_collection_parallel<collection_type>(
+              [&](auto task) { threads.emplace_back(task); });
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      benchmark::DoNotOptimize(members.front());
+    } else {
+      auto members =
+          container.template construct_collection<collection_type>();
+      benchmark::DoNotOptimize(members.front());
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK_TEMPLATE(resolve_container_unique_int,
                    dingo::dynamic_container_traits)
     ->UseRealTime();
@@ -390,6 +635,12 @@ BENCHMARK_TEMPLATE(resolve_container_unique_string,
 
 BENCHMARK_TEMPLATE(resolve_container_shared, dingo::dynamic_container_traits)
     ->UseRealTime();
+BENCHMARK_TEMPLATE(resolve_container_shared, dense_container_traits)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(resolve_container_shared_handle,
+                   dingo::dynamic_container_traits)
+    ->UseRealTime();
 
 BENCHMARK_TEMPLATE(resolve_container_shared_ptr,
                    dingo::dynamic_container_traits)
@@ -406,12 +657,25 @@ BENCHMARK_TEMPLATE(resolve_container_shared_ptr_conversion_resolver,
 BENCHMARK_TEMPLATE(resolve_container_external, dingo::dynamic_container_traits)
     ->UseRealTime();
 
+BENCHMARK_TEMPLATE(resolve_container_keyed, false)->Arg(16)->Arg(1000);
+BENCHMARK_TEMPLATE(resolve_container_keyed, true)->Arg(16)->Arg(1000);
+BENCHMARK_TEMPLATE(resolve_container_collection_first, false);
+BENCHMARK_TEMPLATE(resolve_container_collection_first, true);
+BENCHMARK_TEMPLATE(construct_container_collection_parallel, false)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(construct_container_collection_parallel, true)
+    ->UseRealTime();
+
 BENCHMARK(resolve_container_cold_external)->Iterations(100)->UseManualTime();
 BENCHMARK(resolve_container_cold_external_value)
     ->Iterations(100)
     ->UseManualTime();
 BENCHMARK(resolve_container_cold_shared)->Iterations(100)->UseManualTime();
 BENCHMARK(resolve_container_cold_dependency)->Iterations(100)->UseManualTime();
+BENCHMARK_TEMPLATE(resolve_container_deep_unique, false);
+BENCHMARK_TEMPLATE(resolve_container_deep_unique, true);
+BENCHMARK_TEMPLATE(resolve_container_batch, false);
+BENCHMARK_TEMPLATE(resolve_container_batch, true);
 BENCHMARK(empty_runtime_transaction);
 BENCHMARK(runtime_transaction_barrier);
 BENCHMARK_TEMPLATE(finish_runtime_transaction, true, true)
@@ -445,4 +709,14 @@ BENCHMARK_TEMPLATE(register_type_arena_10,
                    dingo::container<dingo::dynamic_container_traits,
                                     dingo::arena_allocator<char>>)
     ->UseRealTime();
+
+BENCHMARK_TEMPLATE(register_type_many, fixed_arena_container_traits, false)
+    ->Arg(1000)
+    ->Arg(10000);
+BENCHMARK_TEMPLATE(register_type_many, keyed_container_traits, false)
+    ->Arg(1000)
+    ->Arg(10000);
+BENCHMARK_TEMPLATE(register_type_many, keyed_container_traits, true)
+    ->Arg(1000)
+    ->Arg(10000);
 } // namespace
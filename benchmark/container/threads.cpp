@@ -0,0 +1,272 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime/concurrency.h>
+#include <dingo/storage/external.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/shared_concurrent.h>
+#include <dingo/storage/unique.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Resolution benchmarks run from 1 to N threads against one container. Each
+// reports `items_per_second` summed over all threads and `per_thread`, the
+// average rate of a single thread; flat aggregate throughput or a dropping
+// per-thread rate as threads are added points at contention on shared state.
+
+namespace {
+
+struct IThreadedClass {
+  virtual ~IThreadedClass() {}
+};
+
+struct IThreadedKeyed {
+  virtual ~IThreadedKeyed() {}
+};
+
+struct IThreadedMember {
+  virtual ~IThreadedMember() {}
+};
+
+template <size_t> struct ThreadedClass : IThreadedClass {};
+template <size_t> struct ThreadedKeyed : IThreadedKeyed {};
+template <size_t> struct ThreadedMember : IThreadedMember {};
+
+constexpr size_t threaded_key_count = 16;
+constexpr size_t threaded_member_count = 4;
+
+template <typename Concurrency>
+struct threaded_container_traits : dingo::dynamic_container_traits {
+  using concurrency_type = Concurrency;
+  using lookup_definition_type =
+      dingo::lookups<dingo::associative<size_t, IThreadedKeyed>,
+                     dingo::collection<IThreadedMember>>;
+};
+
+using serialized_traits = threaded_container_traits<dingo::single_threaded>;
+using concurrent_traits = threaded_container_traits<dingo::concurrent>;
+
+template <typename ContainerTraits>
+using threaded_container = dingo::container<ContainerTraits>;
+
+// Builds the fixture on the first thread and resolves from all of them.
+// Containers without concurrent resolution are serialized by an external
+// mutex, which is what callers have to do for them.
+template <typename ContainerTraits, typename Fixture, typename Setup,
+          typename Resolve>
+static void resolve_threads(benchmark::State &state, Setup setup,
+                            Resolve resolve) {
+  constexpr bool is_concurrent = std::is_same_v<
+      dingo::detail::container_concurrency_type_t<ContainerTraits>,
+      dingo::concurrent>;
+  static std::unique_ptr<Fixture> fixture;
+  static std::mutex mutex;
+  if (state.thread_index() == 0) {
+    fixture = std::make_unique<Fixture>();
+    setup(*fixture);
+  }
+
+  size_t count = 0;
+  size_t index = state.thread_index();
+  for (auto _ : state) {
+    if constexpr (is_concurrent) {
+      count += resolve(*fixture, index++);
+    } else {
+      std::lock_guard<std::mutex> lock(mutex);
+      count += resolve(*fixture, index++);
+    }
+  }
+  benchmark::DoNotOptimize(count);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["per_thread"] =
+      benchmark::Counter(static_cast<double>(state.iterations()),
+                         benchmark::Counter::kAvgThreadsRate);
+
+  if (state.thread_index() == 0) {
+    fixture.reset();
+  }
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_shared(benchmark::State &state) {
+  using namespace dingo;
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        container.template register_type<scope<shared>,
+                                         storage<ThreadedClass<0>>,
+                                         interfaces<IThreadedClass>>();
+      },
+      [](container_type &container, size_t) {
+        return container.template resolve<IThreadedClass *>() != nullptr;
+      });
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_shared_concurrent(benchmark::State &state) {
+  using namespace dingo;
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        container.template register_type<scope<shared_concurrent>,
+                                         storage<ThreadedClass<0>>,
+                                         interfaces<IThreadedClass>>();
+      },
+      [](container_type &container, size_t) {
+        return container.template resolve<IThreadedClass *>() != nullptr;
+      });
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_unique(benchmark::State &state) {
+  using namespace dingo;
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        container.template register_type<scope<unique>,
+                                         storage<std::unique_ptr<int>>>();
+      },
+      [](container_type &container, size_t) {
+        return container.template resolve<std::unique_ptr<int>>() != nullptr;
+      });
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_external(benchmark::State &state) {
+  using namespace dingo;
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        container.template register_type<scope<external>, storage<int>>(1);
+      },
+      [](container_type &container, size_t) {
+        return container.template resolve<int &>() == 1;
+      });
+}
+
+template <typename Container, size_t... Indices>
+static void register_threaded_keyed(Container &container,
+                                    std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<scope<shared>,
+                                    storage<ThreadedKeyed<Indices>>,
+                                    interfaces<IThreadedKeyed>>(
+       key_value{size_t(Indices)}),
+   ...);
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_keyed(benchmark::State &state) {
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        register_threaded_keyed(container,
+                                std::make_index_sequence<threaded_key_count>());
+      },
+      [](container_type &container, size_t index) {
+        return container.template resolve<IThreadedKeyed *>(
+                   index % threaded_key_count) != nullptr;
+      });
+}
+
+template <typename Container, size_t... Indices>
+static void register_threaded_members(Container &container,
+                                      std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<scope<shared>,
+                                    storage<ThreadedMember<Indices>>,
+                                    interfaces<IThreadedMember>>(),
+   ...);
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_collection(benchmark::State &state) {
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        register_threaded_members(
+            container, std::make_index_sequence<threaded_member_count>());
+      },
+      [](container_type &container, size_t) {
+        return container
+            .template resolve<std::vector<IThreadedMember *>>()
+            .size();
+      });
+}
+
+template <typename ContainerTraits>
+static void resolve_threads_collection_view(benchmark::State &state) {
+  using container_type = threaded_container<ContainerTraits>;
+  resolve_threads<ContainerTraits, container_type>(
+      state,
+      [](container_type &container) {
+        register_threaded_members(
+            container, std::make_index_sequence<threaded_member_count>());
+      },
+      [](container_type &container, size_t) {
+        return container.template view<IThreadedMember *>().size();
+      });
+}
+
+// Requests miss in the child and are resolved by the parent.
+template <typename ContainerTraits> struct parent_fallback_fixture {
+  using container_type = threaded_container<ContainerTraits>;
+  using child_type =
+      dingo::container<ContainerTraits, typename container_type::allocator_type,
+                       container_type>;
+
+  container_type parent;
+  child_type child{&parent};
+};
+
+template <typename ContainerTraits>
+static void resolve_threads_parent_fallback(benchmark::State &state) {
+  using namespace dingo;
+  using fixture_type = parent_fallback_fixture<ContainerTraits>;
+  resolve_threads<ContainerTraits, fixture_type>(
+      state,
+      [](fixture_type &fixture) {
+        fixture.parent.template register_type<scope<shared>,
+                                              storage<ThreadedClass<0>>,
+                                              interfaces<IThreadedClass>>();
+        fixture.child.template register_type<scope<shared>,
+                                             storage<ThreadedClass<1>>>();
+      },
+      [](fixture_type &fixture, size_t) {
+        return fixture.child.template resolve<IThreadedClass *>() != nullptr;
+      });
+}
+
+} // namespace
+
+#define DINGO_THREADED_BENCHMARK(name)                                         \
+  BENCHMARK_TEMPLATE(name, serialized_traits)                                  \
+      ->ThreadRange(1, 8)                                                      \
+      ->UseRealTime();                                                         \
+  BENCHMARK_TEMPLATE(name, concurrent_traits)->ThreadRange(1, 8)->UseRealTime()
+
+DINGO_THREADED_BENCHMARK(resolve_threads_shared);
+DINGO_THREADED_BENCHMARK(resolve_threads_shared_concurrent);
+DINGO_THREADED_BENCHMARK(resolve_threads_unique);
+DINGO_THREADED_BENCHMARK(resolve_threads_external);
+DINGO_THREADED_BENCHMARK(resolve_threads_keyed);
+DINGO_THREADED_BENCHMARK(resolve_threads_collection);
+DINGO_THREADED_BENCHMARK(resolve_threads_collection_view);
+DINGO_THREADED_BENCHMARK(resolve_threads_parent_fallback);
@@ -6,13 +6,17 @@
 //
 
 #include <dingo/container.h>
+#include <dingo/static_container.h>
 #include <dingo/storage/external.h>
 #include <dingo/storage/shared.h>
 #include <dingo/storage/unique.h>
 
 #include <benchmark/benchmark.h>
 
+#include <random>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 struct Message {
   int value;
@@ -123,3 +127,117 @@ BENCHMARK_TEMPLATE(index_ptr_shared, dingo::container<dynamic_container_traits>)
 
 BENCHMARK_TEMPLATE(index_ptr_unique, dingo::container<dynamic_container_traits>)
     ->UseRealTime();
+
+template <std::size_t Index> struct KeyedProcessor : IProcessor {
+  void process(const MessageWrapper &message) override { message.GetMessage(); }
+};
+
+template <typename Container, std::size_t... Indices>
+static void register_keyed_processors(Container &container,
+                                      std::index_sequence<Indices...>) {
+  using namespace dingo;
+  (container.template register_type<scope<shared>,
+                                    storage<KeyedProcessor<Indices>>,
+                                    interfaces<IProcessor>>(
+       dingo::key_value{size_t(Indices)}),
+   ...);
+}
+
+constexpr size_t keyed_processor_count = 16;
+
+template <typename Container>
+static void run_keyed_dispatch(benchmark::State &state, Container &container) {
+  // Keys arrive in an order the branch predictor cannot learn.
+  std::vector<size_t> keys(1024);
+  std::minstd_rand random;
+  for (auto &key : keys) {
+    key = random() % keyed_processor_count;
+  }
+
+  MessageWrapper msg(Message{1});
+  size_t index = 0;
+  for (auto _ : state) {
+    container.template resolve<IProcessor *>(keys[index])->process(msg);
+    index = (index + 1) % keys.size();
+  }
+
+  state.SetBytesProcessed(state.iterations());
+}
+
+template <typename Container>
+static void index_backend_dispatch(benchmark::State &state) {
+  Container container;
+  register_keyed_processors(container,
+                            std::make_index_sequence<keyed_processor_count>());
+  run_keyed_dispatch(state, container);
+}
+
+template <typename Container>
+static void index_static_dispatch(benchmark::State &state) {
+  Container container;
+  run_keyed_dispatch(state, container);
+}
+
+template <std::size_t... Indices>
+static auto make_static_keyed_source(std::index_sequence<Indices...>)
+    -> dingo::bindings<
+        dingo::bind<dingo::scope<dingo::shared>,
+                    dingo::storage<KeyedProcessor<Indices>>,
+                    dingo::interfaces<IProcessor>,
+                    dingo::key_type<size_t, Indices>>...>;
+
+struct static_keyed_traits : dingo::static_container_traits {
+  using lookup_definition_type =
+      dingo::lookups<dingo::associative<size_t, IProcessor>>;
+};
+
+using static_keyed_container = dingo::static_container<
+    decltype(make_static_keyed_source(
+        std::make_index_sequence<keyed_processor_count>())),
+    static_keyed_traits>;
+
+template <typename Backend>
+struct backend_container_traits : dingo::dynamic_container_traits {
+  using lookup_definition_type = dingo::lookups<
+      dingo::associative<size_t, IProcessor, dingo::one, Backend>>;
+};
+
+BENCHMARK_TEMPLATE(index_value_shared,
+                   dingo::container<backend_container_traits<dingo::ordered>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_value_shared,
+    dingo::container<backend_container_traits<dingo::unordered>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_value_shared,
+    dingo::container<backend_container_traits<dingo::array<16>>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_value_shared,
+    dingo::container<backend_container_traits<dingo::flat_unordered>>)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(index_backend_dispatch,
+                   dingo::container<backend_container_traits<dingo::ordered>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_backend_dispatch,
+    dingo::container<backend_container_traits<dingo::unordered>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_backend_dispatch,
+    dingo::container<backend_container_traits<dingo::array<16>>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    index_backend_dispatch,
+    dingo::container<backend_container_traits<dingo::flat_unordered>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(index_value_shared,
+                   dingo::container<backend_container_traits<dingo::sorted>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(index_backend_dispatch,
+                   dingo::container<backend_container_traits<dingo::sorted>>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(index_static_dispatch, static_keyed_container)
+    ->UseRealTime();
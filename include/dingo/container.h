@@ -8,6 +8,7 @@
 #pragma once
 
 #include <dingo/core/auto_constructible.h>
+#include <dingo/core/binding_handle.h>
 #include <dingo/core/binding_collection.h>
 #include <dingo/core/binding_model.h>
 #include <dingo/core/binding_resolution_policy.h>
@@ -16,6 +17,7 @@
 #include <dingo/core/dependency.h>
 #include <dingo/core/exceptions.h>
 #include <dingo/core/none.h>
+#include <dingo/core/warm_up.h>
 #include <dingo/detail/container_base.h>
 #include <dingo/detail/container_traits.h>
 #include <dingo/factory/callable.h>
@@ -31,19 +33,23 @@
 #include <dingo/rtti/typeid_provider.h>
 #include <dingo/runtime/container_traits.h>
 #include <dingo/runtime/context.h>
+#include <dingo/runtime/observer.h>
 #include <dingo/runtime_container.h>
 #include <dingo/static/container_traits.h>
 #include <dingo/static/local_resolution.h>
 #include <dingo/static/resolution.h>
+#include <dingo/static/warm_up.h>
 #include <dingo/storage/interface_storage_traits.h>
 #include <dingo/type/complete_type.h>
 #include <dingo/type/dependency_traits.h>
 #include <dingo/type/normalized_type.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 #include <typeindex>
 #include <utility>
@@ -370,6 +376,8 @@ public:
   using container_traits_type = typename runtime_base::container_traits_type;
   using allocator_type = typename runtime_base::allocator_type;
   using rtti_type = typename runtime_base::rtti_type;
+  using observer_type =
+      detail::container_observer_type_t<container_traits_type>;
 
   static_assert(static_bindings_type::valid,
                 "container requires a valid compile-time bindings source");
@@ -493,6 +501,8 @@ private:
   template <typename Request, typename R, typename LookupKey>
   R resolve_entry(LookupKey key) {
     using interface_type = typename Request::interface_type;
+    detail::resolve_observation<observer_type> observation(
+        describe_type<typename Request::user_type>());
     if constexpr (is_cacheable<Request, R, LookupKey>()) {
       auto selection =
           runtime_registry_
@@ -500,6 +510,8 @@ private:
       auto result =
           runtime_registry_.template lookup_cache<interface_type>(selection);
       if (result.hit) {
+        detail::observe_cache_hit<observer_type>(
+            describe_type<typename Request::user_type>());
         return runtime_registry_.template resolve_cached<interface_type, R>(
             result);
       }
@@ -520,6 +532,47 @@ private:
         });
   }
 
+  // Resolves a request of resolve_all() in the context of the batch.
+  template <typename T, typename LookupKey>
+  typename request_type<T, true>::result_type
+  resolve_batched(runtime_context_type &context, LookupKey key) {
+    using request = request_type<T>;
+    detail::resolve_observation<observer_type> observation(
+        describe_type<typename request::user_type>());
+    return resolve<request, typename request_type<T, true>::result_type>(
+        ephemeral_scope, context, *this, std::move(key));
+  }
+
+  template <typename... Bindings>
+  void warm_up_static(detail::warm_up_filter filter, warm_up_report &report,
+                      type_list<Bindings...>) {
+    (warm_up_static_binding<Bindings>(filter, report), ...);
+  }
+
+  // Runs in a transaction nested in the warm-up one.
+  template <typename Binding>
+  void warm_up_static_binding(detail::warm_up_filter filter,
+                              warm_up_report &report) {
+    using interface_type = typename Binding::interface_type;
+    using key_type = typename Binding::key_type;
+    if constexpr (detail::static_warm_up_binding_v<Binding,
+                                                   static_registry_type>) {
+      const auto type = describe_type<normalized_type_t<interface_type>>();
+      if (!filter.accepts(type)) {
+        return;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      (void)resolve<interface_type &>(key_type{});
+      const auto finish = std::chrono::steady_clock::now();
+      report.push_back(
+          {type, std::chrono::duration_cast<std::chrono::nanoseconds>(finish -
+                                                                      start)});
+    } else {
+      (void)filter;
+      (void)report;
+    }
+  }
+
 public:
   template <typename T, typename IdType = none_t,
             typename R = typename request_type<T, true>::result_type,
@@ -538,6 +591,99 @@ public:
     return resolve_entry<request, R>(std::move(key));
   }
 
+  // Resolves all requests in one transaction, in order. If a request throws,
+  // instances constructed for the earlier ones are rolled back with it.
+  template <typename... Ts>
+  std::tuple<typename request_type<Ts, true>::result_type...> resolve_all() {
+    using result_type =
+        std::tuple<typename request_type<Ts, true>::result_type...>;
+    // Every request resolves in the context of the batch transaction, so a
+    // failure rolls back the whole batch.
+    return execute_transaction(
+        runtime_registry_.runtime(),
+        [&](runtime_context_type &context) -> result_type {
+          return result_type{
+              resolve_batched<Ts>(context, detail::no_lookup_key())...};
+        });
+  }
+
+  // Resolves `T` for every runtime key in [first, last) in one transaction
+  // and writes the results to `out`.
+  template <typename T, typename InputIt, typename OutputIt>
+  OutputIt resolve_all(InputIt first, InputIt last, OutputIt out) {
+    return execute_transaction(
+        runtime_registry_.runtime(),
+        [&](runtime_context_type &context) -> OutputIt {
+          for (; first != last; ++first) {
+            *out = resolve_batched<T>(context, detail::make_lookup_key(*first));
+            ++out;
+          }
+          return out;
+        });
+  }
+
+  // Resolves `T` once and returns a handle to its address. The binding must
+  // keep a stable address (shared or external storage).
+  template <typename T, typename IdType = none_t,
+            typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<!detail::is_lookup_key_v<IdType>, int> = 0>
+  binding_handle<R> handle(IdType &&id = IdType()) {
+    return handle<T>(detail::make_lookup_key(std::forward<IdType>(id)));
+  }
+
+  template <typename T, typename LookupKey,
+            typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  binding_handle<R> handle(LookupKey key) {
+    using request = request_type<T>;
+    using lookup_type = typename request::lookup_type;
+    static_assert(detail::cache::supports_v<R> &&
+                      !collection_traits<R>::is_collection,
+                  "binding handle requires a reference or pointer request");
+    if constexpr (!is_cacheable<request, R, LookupKey>()) {
+      using static_selection =
+          typename static_registry_type::template selection<lookup_type,
+                                                            LookupKey>;
+      static_assert(detail::static_binding_is_stable_v<
+                        typename static_selection::binding_type>,
+                    "binding handle requires stable storage");
+      return binding_handle<R>(resolve<T>(std::move(key)));
+    } else {
+      auto selection =
+          runtime_registry_.template select_binding<lookup_type>(key);
+      if constexpr (has_parent_v) {
+        if (parent_ && selection.status == detail::binding_status::not_found) {
+          return parent_->template handle<T>(std::move(key));
+        }
+      }
+      runtime_registry_.template check_stable_binding<lookup_type>(selection);
+      return binding_handle<R>(resolve<T>(std::move(key)));
+    }
+  }
+
+  // Reserves memory for about `count` runtime registrations up front, so
+  // that registering them does not request many small arena blocks.
+  void reserve_bindings(std::size_t count) {
+    runtime_registry_.reserve_bindings(count);
+  }
+
+  // Materializes the shared bindings of this container, static ones first,
+  // in one transaction and reports how long each took.
+  // `warm_up<Interfaces...>()` restricts it to the given interfaces.
+  template <typename... Interfaces> warm_up_report warm_up() {
+    const auto filter = detail::warm_up_interfaces<Interfaces...>::filter();
+    warm_up_report report;
+    execute_transaction(runtime_registry_.runtime(),
+                        [&](runtime_context_type &context) {
+                          warm_up_static(filter, report,
+                                         typename static_registry_type::
+                                             static_bindings_type::
+                                                 interface_bindings{});
+                          runtime_registry_.warm_up(context, filter, report);
+                        });
+    return report;
+  }
+
   template <typename T, typename Factory = constructor<normalized_type_t<T>>,
             typename R = typename request_type<T, true>::result_type>
   // NOLINTNEXTLINE(readability-function-cognitive-complexity,readability-function-size)
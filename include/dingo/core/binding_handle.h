@@ -0,0 +1,54 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace dingo {
+// Address of a binding resolved once by `container.handle<T>()`. Reading it
+// is a single pointer load with no lookup. Handles are only created for
+// bindings whose storage keeps a stable address; instances handed out by a
+// committed resolution are never rolled back, so a handle stays valid for the
+// lifetime of the container that owns the binding.
+template <typename T> class binding_handle {
+  static_assert(std::is_lvalue_reference_v<T> || std::is_pointer_v<T>,
+                "binding_handle requires a reference or pointer type");
+
+public:
+  using value_type = std::remove_pointer_t<std::remove_reference_t<T>>;
+
+  binding_handle() = default;
+
+  explicit binding_handle(T value) noexcept : address_(address_of(value)) {}
+
+  T get() const noexcept {
+    if constexpr (std::is_pointer_v<T>) {
+      return address_;
+    } else {
+      return *address_;
+    }
+  }
+
+  value_type &operator*() const noexcept { return *address_; }
+  value_type *operator->() const noexcept { return address_; }
+
+  explicit operator bool() const noexcept { return address_ != nullptr; }
+
+private:
+  static value_type *address_of(T value) noexcept {
+    if constexpr (std::is_pointer_v<T>) {
+      return value;
+    } else {
+      return std::addressof(value);
+    }
+  }
+
+  value_type *address_ = nullptr;
+};
+} // namespace dingo
@@ -0,0 +1,46 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+namespace dingo {
+// Read-only contiguous range of collection elements returned by
+// `container.view<T>()`. The elements are owned by the container and stay
+// valid until a registration changes the collection and the container
+// materializes a newer view of it.
+template <typename T> class collection_view {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_iterator = const T *;
+  using iterator = const_iterator;
+
+  collection_view() = default;
+
+  collection_view(const T *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  const T *data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  const T &operator[](std::size_t index) const noexcept {
+    assert(index < size_);
+    return data_[index];
+  }
+
+private:
+  const T *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+} // namespace dingo
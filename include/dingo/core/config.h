@@ -19,6 +19,25 @@
 #define DINGO_RUNTIME_ARENA_BLOCK_SIZE 256
 #endif
 
+#if !defined(DINGO_RUNTIME_ARENA_MAX_BLOCK_SIZE)
+#define DINGO_RUNTIME_ARENA_MAX_BLOCK_SIZE 16384
+#endif
+
+#if !defined(DINGO_RUNTIME_BINDING_RESERVE_SIZE)
+#define DINGO_RUNTIME_BINDING_RESERVE_SIZE 64
+#endif
+
+// Attributes of the accessor of the process-wide interned type table. On
+// Windows, define it to __declspec(dllexport) in the module owning the table
+// and to __declspec(dllimport) elsewhere to share ids between DLLs.
+#if !defined(DINGO_RTTI_INTERNED_TABLE_API)
+#if defined(__GNUC__) || defined(__clang__)
+#define DINGO_RTTI_INTERNED_TABLE_API __attribute__((visibility("default")))
+#else
+#define DINGO_RTTI_INTERNED_TABLE_API
+#endif
+#endif
+
 #if !defined(DINGO_ALWAYS_INLINE)
 #if defined(_MSC_VER)
 #define DINGO_ALWAYS_INLINE __forceinline
@@ -39,6 +58,16 @@
 #endif
 #endif
 
+// Inlines every call made from the annotated function into its body. Used by
+// static containers whose traits select `flattened_resolution`.
+#if !defined(DINGO_FLATTEN)
+#if defined(__GNUC__) || defined(__clang__)
+#define DINGO_FLATTEN __attribute__((flatten))
+#else
+#define DINGO_FLATTEN
+#endif
+#endif
+
 #if __cplusplus > 202002L || (defined(_MSVC_LANG) && _MSVC_LANG > 202002L)
 #define DINGO_CXX_STANDARD 23
 #elif (__cplusplus > 201703L && __cplusplus <= 202002L) ||                     \
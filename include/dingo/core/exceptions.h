@@ -63,6 +63,10 @@ struct virtual_pointer_exception : exception {
   using exception::exception;
 };
 
+struct container_frozen_exception : exception {
+  using exception::exception;
+};
+
 #ifdef _DEBUG
 struct arena_allocation_exception : exception {
   using exception::exception;
@@ -208,6 +212,13 @@ make_type_not_convertible_exception(type_descriptor target_type,
   return type_not_convertible_exception(std::move(message));
 }
 
+template <typename Type>
+type_not_convertible_exception make_unstable_binding_exception() {
+  std::string message = "binding handle requires stable storage for: ";
+  append_type_name(message, describe_type<Type>());
+  return type_not_convertible_exception(std::move(message));
+}
+
 template <typename Type>
 type_recursion_exception make_type_recursion_exception() {
   std::string message = "recursive dependency detected while constructing: ";
@@ -267,6 +278,11 @@ make_lookup_already_registered_exception(const LookupKey &key,
   return lookup_already_registered_exception(std::move(message));
 }
 
+inline container_frozen_exception make_container_frozen_exception() {
+  return container_frozen_exception(
+      "container is frozen and accepts no further registrations");
+}
+
 template <typename Key>
 type_index_out_of_range_exception
 make_type_index_out_of_range_exception(Key, size_t) {
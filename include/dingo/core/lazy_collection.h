@@ -0,0 +1,199 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dingo {
+namespace detail {
+// Member bindings of a lazy collection, kept in a container allocated with
+// the container's allocator. The block owning it is allocated the same way
+// and carries the functions to copy and free it, so a range can be copied and
+// destroyed without the container.
+class lazy_collection_bindings {
+  struct block {
+    void (*destroy)(block *) noexcept;
+    block *(*clone)(const block &);
+    void *const *data;
+    std::size_t size;
+  };
+
+  template <typename Bindings> struct owned_block : block {
+    using allocator_type = typename std::allocator_traits<
+        typename Bindings::allocator_type>::template rebind_alloc<owned_block>;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+
+    explicit owned_block(Bindings &&values)
+        : block{&destroy_block, &clone_block, nullptr, 0},
+          bindings(std::move(values)) {
+      this->data = bindings.data();
+      this->size = bindings.size();
+    }
+
+    static block *create(Bindings &&values) {
+      allocator_type allocator(values.get_allocator());
+      auto *created = allocator_traits::allocate(allocator, 1);
+      try {
+        allocator_traits::construct(allocator, created, std::move(values));
+      } catch (...) {
+        allocator_traits::deallocate(allocator, created, 1);
+        throw;
+      }
+      return created;
+    }
+
+    static void destroy_block(block *value) noexcept {
+      auto *owned = static_cast<owned_block *>(value);
+      allocator_type allocator(owned->bindings.get_allocator());
+      allocator_traits::destroy(allocator, owned);
+      allocator_traits::deallocate(allocator, owned, 1);
+    }
+
+    static block *clone_block(const block &value) {
+      return create(Bindings(static_cast<const owned_block &>(value).bindings));
+    }
+
+    Bindings bindings;
+  };
+
+public:
+  lazy_collection_bindings() = default;
+
+  // Takes over `bindings`, a vector of `void *` using the container's
+  // allocator. An empty range allocates nothing.
+  template <typename Bindings>
+  explicit lazy_collection_bindings(Bindings &&bindings)
+      : block_(bindings.empty()
+                   ? nullptr
+                   : owned_block<std::decay_t<Bindings>>::create(
+                         std::move(bindings))) {}
+
+  lazy_collection_bindings(const lazy_collection_bindings &other)
+      : block_(other.block_ ? other.block_->clone(*other.block_) : nullptr) {}
+
+  lazy_collection_bindings(lazy_collection_bindings &&other) noexcept
+      : block_(std::exchange(other.block_, nullptr)) {}
+
+  lazy_collection_bindings &operator=(lazy_collection_bindings other) noexcept {
+    std::swap(block_, other.block_);
+    return *this;
+  }
+
+  ~lazy_collection_bindings() {
+    if (block_) {
+      block_->destroy(block_);
+    }
+  }
+
+  void *const *data() const noexcept { return block_ ? block_->data : nullptr; }
+  std::size_t size() const noexcept { return block_ ? block_->size : 0; }
+
+private:
+  block *block_ = nullptr;
+};
+} // namespace detail
+
+// Collection resolved by `container.resolve<lazy_collection<T>>()`. It holds
+// the member bindings selected by the collection lookup and resolves an
+// element only when its iterator is dereferenced, so a consumer that stops
+// early never constructs the remaining members. Each dereference resolves
+// anew: shared members return their instance, unique members construct a
+// new one every time. The range refers to its container by a raw pointer:
+// it may be copied and destroyed after the container is gone, but
+// dereferencing it then is undefined behavior.
+template <typename T> class lazy_collection {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using resolve_function = T (*)(void *container, void *binding);
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = T;
+
+    iterator() = default;
+
+    T operator*() const { return owner_->resolve(*binding_); }
+
+    iterator &operator++() {
+      ++binding_;
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator result = *this;
+      ++binding_;
+      return result;
+    }
+
+    bool operator==(const iterator &other) const {
+      return binding_ == other.binding_;
+    }
+
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    friend class lazy_collection;
+
+    iterator(const lazy_collection *owner, void *const *binding)
+        : owner_(owner), binding_(binding) {}
+
+    const lazy_collection *owner_ = nullptr;
+    void *const *binding_ = nullptr;
+  };
+
+  using const_iterator = iterator;
+
+  lazy_collection() = default;
+
+  lazy_collection(void *container, resolve_function resolve_fn,
+                  detail::lazy_collection_bindings bindings)
+      : container_(container), resolve_(resolve_fn),
+        bindings_(std::move(bindings)) {}
+
+  std::size_t size() const noexcept { return bindings_.size(); }
+  bool empty() const noexcept { return bindings_.size() == 0; }
+
+  iterator begin() const { return iterator(this, bindings_.data()); }
+  iterator end() const {
+    return iterator(this, bindings_.data() + bindings_.size());
+  }
+
+  T operator[](std::size_t index) const {
+    assert(index < bindings_.size());
+    return resolve(bindings_.data()[index]);
+  }
+
+private:
+  T resolve(void *binding) const { return resolve_(container_, binding); }
+
+  void *container_ = nullptr;
+  resolve_function resolve_ = nullptr;
+  detail::lazy_collection_bindings bindings_;
+};
+
+namespace detail {
+template <typename T> struct is_lazy_collection : std::false_type {};
+
+template <typename T>
+struct is_lazy_collection<lazy_collection<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_lazy_collection_v =
+    is_lazy_collection<std::decay_t<T>>::value;
+} // namespace detail
+} // namespace dingo
@@ -0,0 +1,76 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/type/normalized_type.h>
+#include <dingo/type/type_descriptor.h>
+
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+struct shared;
+struct shared_concurrent;
+struct shared_cyclical;
+
+// A binding materialized by `container.warm_up()`. The duration includes the
+// construction of dependencies that were not materialized before it.
+struct warm_up_entry {
+  type_descriptor interface_type;
+  std::chrono::nanoseconds duration;
+};
+
+using warm_up_report = std::vector<warm_up_entry>;
+
+namespace detail {
+template <typename Tag>
+inline constexpr bool is_warm_up_storage_v =
+    std::is_same_v<Tag, shared> || std::is_same_v<Tag, shared_concurrent> ||
+    std::is_same_v<Tag, shared_cyclical>;
+
+struct warm_up_tag {};
+
+struct warm_up_filter {
+  const type_descriptor *first = nullptr;
+  const type_descriptor *last = nullptr;
+
+  bool accepts(type_descriptor type) const {
+    if (first == last) {
+      return true;
+    }
+    for (auto it = first; it != last; ++it) {
+      if (*it == type) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+template <typename... Interfaces> struct warm_up_interfaces {
+  static constexpr type_descriptor values[] = {
+      describe_type<normalized_type_t<Interfaces>>()...};
+
+  static constexpr warm_up_filter filter() {
+    return {values, values + sizeof...(Interfaces)};
+  }
+};
+
+template <> struct warm_up_interfaces<> {
+  static constexpr warm_up_filter filter() { return {}; }
+};
+
+struct warm_up_result {
+  bool warmed = false;
+  type_descriptor interface_type{};
+  const void *cache_key = nullptr;
+};
+} // namespace detail
+} // namespace dingo
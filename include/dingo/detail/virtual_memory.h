@@ -0,0 +1,90 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+
+#include <cstddef>
+
+// <windows.h> is included with min/max macros and rarely used APIs disabled,
+// and the macros defined for it here do not leak into the includer.
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#define DINGO_VIRTUAL_MEMORY_NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#define DINGO_VIRTUAL_MEMORY_WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#if defined(DINGO_VIRTUAL_MEMORY_NOMINMAX)
+#undef NOMINMAX
+#undef DINGO_VIRTUAL_MEMORY_NOMINMAX
+#endif
+#if defined(DINGO_VIRTUAL_MEMORY_WIN32_LEAN_AND_MEAN)
+#undef WIN32_LEAN_AND_MEAN
+#undef DINGO_VIRTUAL_MEMORY_WIN32_LEAN_AND_MEAN
+#endif
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dingo::detail {
+// Thin wrappers over the platform virtual memory API: ranges are reserved
+// without access, committed on demand and released as a whole.
+inline std::size_t virtual_memory_page_size() {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  ::GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+inline void *virtual_memory_reserve(std::size_t size) {
+#if defined(_WIN32)
+  return ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+  void *ptr = ::mmap(nullptr, size, PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return ptr != MAP_FAILED ? ptr : nullptr;
+#endif
+}
+
+inline bool virtual_memory_commit(void *ptr, std::size_t size) {
+#if defined(_WIN32)
+  return ::VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+  return ::mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+inline void virtual_memory_release(void *ptr, std::size_t size) {
+#if defined(_WIN32)
+  (void)size;
+  ::VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+  ::munmap(ptr, size);
+#endif
+}
+
+// Asks for transparent huge pages; false when the system does not support
+// them for the range.
+inline bool virtual_memory_advise_huge(void *ptr, std::size_t size) {
+#if defined(MADV_HUGEPAGE)
+  return ::madvise(ptr, size, MADV_HUGEPAGE) == 0;
+#else
+  (void)ptr;
+  (void)size;
+  return false;
+#endif
+}
+} // namespace dingo::detail
@@ -136,6 +136,14 @@ public:
     }
   }
 
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    for (auto &entry : entries_) {
+      if (entry.second) {
+        fn(*entry.second);
+      }
+    }
+  }
+
 private:
   static std::optional<std::size_t> to_index(const Key &key) {
     return array_lookup_index(key, Size);
@@ -281,6 +289,14 @@ public:
 
   void erase(iterator handle) { values_[handle.index_].erase(handle.it_); }
 
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    for (auto &bucket : values_) {
+      for (auto &value : bucket) {
+        fn(value);
+      }
+    }
+  }
+
 private:
   static std::optional<std::size_t> to_index(const Key &key) {
     return array_lookup_index(key, Size);
@@ -16,6 +16,7 @@
 #include <functional>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace dingo {
 template <typename Cardinality = one, typename Backend = ordered> struct base {
@@ -53,6 +54,30 @@ template <typename Rtti> struct base_lookup_key {
   }
 };
 
+template <typename TypeIndex, typename = void>
+struct has_dense_type_index : std::false_type {};
+
+template <typename TypeIndex>
+struct has_dense_type_index<
+    TypeIndex, std::void_t<decltype(std::declval<const TypeIndex &>().value())>>
+    : std::true_type {};
+
+// Positions base lookup rows of the dense backend by interface id.
+template <typename Rtti>
+std::size_t dense_lookup_position(const base_lookup_key<Rtti> &key) {
+  static_assert(has_dense_type_index<typename Rtti::type_index>::value,
+                "dingo::dense base lookup requires an RTTI provider with "
+                "dense type ids, such as dingo::interned_provider");
+  return static_cast<std::size_t>(key.interface_type.value());
+}
+
+// Only unkeyed rows take a dense position; typed keys of the same interface
+// would otherwise compete with them for it.
+template <typename Rtti>
+bool dense_lookup_unkeyed(const base_lookup_key<Rtti> &key) {
+  return key.key_type == Rtti::template get_type_index<::dingo::none_t>();
+}
+
 template <typename Rtti> struct base_lookup_interface {};
 
 template <typename Rtti, typename Cardinality, typename Backend>
@@ -0,0 +1,187 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/lookup/storage.h>
+#include <dingo/lookup/tags.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dingo {
+namespace detail {
+
+template <typename Key, typename Value, typename Cardinality,
+          typename Allocator>
+class dense_lookup_storage {
+  static_assert(std::is_same_v<Cardinality, ::dingo::one>,
+                "dingo::dense lookup backend requires dingo::one cardinality");
+};
+
+// Unkeyed rows live in pages of slots indexed by dense_lookup_position(key),
+// found by ADL together with dense_lookup_unkeyed(key). Pages are allocated
+// on first use, so a container pays for the id ranges it registers and one
+// page entry per page_size ids below the largest of them, not for every id in
+// the process. Typed keys live in an ordered overflow map, so they never take
+// the slot an unkeyed lookup of the same interface indexes.
+template <typename Key, typename Value, typename Allocator>
+class dense_lookup_storage<Key, Value, ::dingo::one, Allocator> {
+  static constexpr std::size_t page_size = 64;
+
+  using row_type = std::pair<const Key, Value>;
+  using slot_type = std::optional<row_type>;
+  using slot_allocator = lookup_storage_allocator_t<slot_type, Allocator>;
+  using page_type = std::vector<slot_type, slot_allocator>;
+  using page_allocator = lookup_storage_allocator_t<page_type, Allocator>;
+  using page_vector = std::vector<page_type, page_allocator>;
+  using overflow_allocator = lookup_storage_allocator_t<row_type, Allocator>;
+  using overflow_map =
+      std::map<Key, Value, std::less<Key>, overflow_allocator>;
+
+  template <typename Reference> class basic_iterator {
+  public:
+    basic_iterator() = default;
+
+    template <typename OtherReference,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<OtherReference *, Reference *>>>
+    basic_iterator(const basic_iterator<OtherReference> &other)
+        : row_(other.row_), overflow_(other.overflow_) {}
+
+    Reference &operator*() const { return *row_; }
+    Reference *operator->() const { return row_; }
+
+    bool operator==(const basic_iterator &other) const {
+      return row_ == other.row_;
+    }
+
+    bool operator!=(const basic_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class dense_lookup_storage;
+    template <typename> friend class basic_iterator;
+
+    basic_iterator(Reference *row, bool overflow)
+        : row_(row), overflow_(overflow) {}
+
+    Reference *row_ = nullptr;
+    bool overflow_ = false;
+  };
+
+public:
+  using iterator = basic_iterator<row_type>;
+  using const_iterator = basic_iterator<const row_type>;
+
+  explicit dense_lookup_storage(Allocator &allocator)
+      : pages_(make_lookup_storage_allocator<page_allocator>(allocator)),
+        overflow_(std::less<Key>(),
+                  make_lookup_storage_allocator<overflow_allocator>(
+                      allocator)) {}
+
+  iterator find(const Key &key) { return find_row<iterator>(*this, key); }
+
+  const_iterator find(const Key &key) const {
+    return find_row<const_iterator>(*this, key);
+  }
+
+  iterator end() { return iterator(); }
+  const_iterator end() const { return const_iterator(); }
+
+  template <typename Inserted>
+  std::pair<iterator, bool> try_emplace(const Key &key, Inserted &&value) {
+    if (!dense_lookup_unkeyed(key)) {
+      auto [it, inserted] =
+          overflow_.try_emplace(key, std::forward<Inserted>(value));
+      return {iterator(&*it, true), inserted};
+    }
+    auto &slot = acquire_slot(dense_lookup_position(key));
+    if (slot) {
+      return {iterator(&*slot, false), false};
+    }
+    slot.emplace(key, std::forward<Inserted>(value));
+    return {iterator(&*slot, false), true};
+  }
+
+  void erase(iterator handle) {
+    if (handle.overflow_) {
+      overflow_.erase(handle->first);
+    } else if (handle.row_) {
+      find_slot(*this, dense_lookup_position(handle->first))->reset();
+    }
+  }
+
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    for (auto &page : pages_) {
+      for (auto &slot : page) {
+        if (slot) {
+          fn(slot->second);
+        }
+      }
+    }
+    for (auto &row : overflow_) {
+      fn(row.second);
+    }
+  }
+
+private:
+  template <typename Iterator, typename Self>
+  static Iterator find_row(Self &self, const Key &key) {
+    if (dense_lookup_unkeyed(key)) {
+      auto *slot = find_slot(self, dense_lookup_position(key));
+      return slot && *slot ? Iterator(&**slot, false) : Iterator();
+    }
+    if (self.overflow_.empty()) {
+      return Iterator();
+    }
+    auto it = self.overflow_.find(key);
+    return it == self.overflow_.end() ? Iterator() : Iterator(&*it, true);
+  }
+
+  // Null when the page holding the position was never allocated.
+  template <typename Self>
+  static auto find_slot(Self &self, std::size_t position)
+      -> decltype(&self.pages_[0][0]) {
+    const auto page = position / page_size;
+    if (page >= self.pages_.size() || self.pages_[page].empty()) {
+      return nullptr;
+    }
+    return &self.pages_[page][position % page_size];
+  }
+
+  slot_type &acquire_slot(std::size_t position) {
+    const auto page = position / page_size;
+    while (pages_.size() <= page) {
+      pages_.emplace_back(slot_allocator(pages_.get_allocator()));
+    }
+    if (pages_[page].empty()) {
+      pages_[page].resize(page_size);
+    }
+    return pages_[page][position % page_size];
+  }
+
+  page_vector pages_;
+  overflow_map overflow_;
+};
+
+} // namespace detail
+
+struct dense {
+  template <typename Key, typename Value, typename Cardinality,
+            typename Allocator>
+  using storage =
+      detail::dense_lookup_storage<Key, Value, Cardinality, Allocator>;
+};
+
+} // namespace dingo
@@ -0,0 +1,583 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/lookup/storage.h>
+#include <dingo/lookup/tags.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(DINGO_FLAT_LOOKUP_SSE2)
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DINGO_FLAT_LOOKUP_SSE2 1
+#else
+#define DINGO_FLAT_LOOKUP_SSE2 0
+#endif
+#endif
+
+#if DINGO_FLAT_LOOKUP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace dingo {
+namespace detail {
+
+// Control byte per slot: a 7-bit hash fragment for occupied slots, or one of
+// the negative markers below. Slots are probed a group at a time.
+enum class flat_lookup_control : std::int8_t { empty = -128, deleted = -2 };
+
+inline constexpr std::size_t flat_lookup_group_width = 16;
+
+inline unsigned flat_lookup_lowest_bit(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+  unsigned index = 0;
+  while ((mask & 1u) == 0) {
+    mask >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+class flat_lookup_group {
+public:
+  explicit flat_lookup_group(const std::int8_t *control)
+#if DINGO_FLAT_LOOKUP_SSE2
+      : control_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control)))
+#else
+      : control_(control)
+#endif
+  {
+  }
+
+  std::uint32_t match(std::int8_t fragment) const {
+#if DINGO_FLAT_LOOKUP_SSE2
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(control_, _mm_set1_epi8(fragment))));
+#else
+    return match_if([fragment](std::int8_t c) { return c == fragment; });
+#endif
+  }
+
+  std::uint32_t match_empty() const {
+    return match(static_cast<std::int8_t>(flat_lookup_control::empty));
+  }
+
+  std::uint32_t match_empty_or_deleted() const {
+#if DINGO_FLAT_LOOKUP_SSE2
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(control_));
+#else
+    return match_if([](std::int8_t c) { return c < 0; });
+#endif
+  }
+
+private:
+#if DINGO_FLAT_LOOKUP_SSE2
+  __m128i control_;
+#else
+  template <typename Predicate>
+  std::uint32_t match_if(Predicate predicate) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < flat_lookup_group_width; ++i) {
+      mask |= static_cast<std::uint32_t>(predicate(control_[i])) << i;
+    }
+    return mask;
+  }
+
+  const std::int8_t *control_;
+#endif
+};
+
+// Open-addressing table with separate arrays for control bytes, keys and
+// mapped values, so probing touches only the control bytes and the keys of
+// candidate slots. Groups are aligned and probed with a triangular sequence,
+// which visits every group of a power-of-two table.
+template <typename Key, typename Mapped, typename Allocator>
+class flat_lookup_table {
+  using control_allocator = lookup_storage_allocator_t<std::int8_t, Allocator>;
+  using key_allocator = lookup_storage_allocator_t<Key, Allocator>;
+  using mapped_allocator = lookup_storage_allocator_t<Mapped, Allocator>;
+
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  explicit flat_lookup_table(Allocator &allocator)
+      : control_allocator_(
+            make_lookup_storage_allocator<control_allocator>(allocator)),
+        key_allocator_(make_lookup_storage_allocator<key_allocator>(allocator)),
+        mapped_allocator_(
+            make_lookup_storage_allocator<mapped_allocator>(allocator)) {}
+
+  flat_lookup_table(flat_lookup_table &&other) noexcept
+      : control_allocator_(other.control_allocator_),
+        key_allocator_(other.key_allocator_),
+        mapped_allocator_(other.mapped_allocator_),
+        control_(std::exchange(other.control_, nullptr)),
+        keys_(std::exchange(other.keys_, nullptr)),
+        mapped_(std::exchange(other.mapped_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)) {}
+
+  flat_lookup_table(const flat_lookup_table &) = delete;
+  flat_lookup_table &operator=(const flat_lookup_table &) = delete;
+  flat_lookup_table &operator=(flat_lookup_table &&) = delete;
+
+  ~flat_lookup_table() { release(control_, keys_, mapped_, capacity_); }
+
+  Mapped &mapped(std::size_t slot) { return mapped_[slot]; }
+  const Mapped &mapped(std::size_t slot) const { return mapped_[slot]; }
+
+  template <typename Fn> void for_each(Fn &&fn) {
+    for (std::size_t slot = 0; slot < capacity_; ++slot) {
+      if (control_[slot] >= 0) {
+        fn(mapped_[slot]);
+      }
+    }
+  }
+
+  std::size_t find(const Key &key) const {
+    if (size_ == 0) {
+      return npos;
+    }
+    const auto hash = hash_of(key);
+    const auto fragment = fragment_of(hash);
+    const std::size_t group_mask = capacity_ / flat_lookup_group_width - 1;
+    std::size_t group = group_of(hash) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      const std::size_t offset = group * flat_lookup_group_width;
+      const flat_lookup_group candidates(control_ + offset);
+      for (auto mask = candidates.match(fragment); mask != 0;
+           mask &= mask - 1) {
+        const std::size_t slot = offset + flat_lookup_lowest_bit(mask);
+        if (std::equal_to<Key>()(keys_[slot], key)) {
+          return slot;
+        }
+      }
+      if (candidates.match_empty() != 0) {
+        return npos;
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  template <typename... Args>
+  std::pair<std::size_t, bool> try_emplace(const Key &key, Args &&...args) {
+    const auto existing = find(key);
+    if (existing != npos) {
+      return {existing, false};
+    }
+    if (growth_left_ == 0) {
+      rehash();
+    }
+
+    const auto hash = hash_of(key);
+    const std::size_t slot = find_insert_slot(hash);
+    ::new (static_cast<void *>(keys_ + slot)) Key(key);
+    try {
+      ::new (static_cast<void *>(mapped_ + slot))
+          Mapped(std::forward<Args>(args)...);
+    } catch (...) {
+      keys_[slot].~Key();
+      throw;
+    }
+    if (control_[slot] == static_cast<std::int8_t>(flat_lookup_control::empty))
+      --growth_left_;
+    control_[slot] = fragment_of(hash);
+    ++size_;
+    return {slot, true};
+  }
+
+  void erase(std::size_t slot) {
+    keys_[slot].~Key();
+    mapped_[slot].~Mapped();
+    --size_;
+    // No probe sequence continues past a group that still has an empty slot,
+    // so the slot can be released without leaving a tombstone behind.
+    const std::size_t offset = slot - slot % flat_lookup_group_width;
+    if (flat_lookup_group(control_ + offset).match_empty() != 0) {
+      control_[slot] = static_cast<std::int8_t>(flat_lookup_control::empty);
+      ++growth_left_;
+    } else {
+      control_[slot] = static_cast<std::int8_t>(flat_lookup_control::deleted);
+    }
+  }
+
+private:
+  static std::uint64_t hash_of(const Key &key) {
+    auto hash = static_cast<std::uint64_t>(std::hash<Key>()(key)) *
+                0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+  }
+
+  static std::int8_t fragment_of(std::uint64_t hash) {
+    return static_cast<std::int8_t>(hash & 0x7F);
+  }
+
+  static std::size_t group_of(std::uint64_t hash) {
+    return static_cast<std::size_t>(hash >> 7);
+  }
+
+  static std::size_t growth_limit(std::size_t capacity) {
+    return capacity - capacity / 8;
+  }
+
+  std::size_t find_insert_slot(std::uint64_t hash) const {
+    const std::size_t group_mask = capacity_ / flat_lookup_group_width - 1;
+    std::size_t group = group_of(hash) & group_mask;
+    for (std::size_t step = 1;; ++step) {
+      const std::size_t offset = group * flat_lookup_group_width;
+      const auto mask =
+          flat_lookup_group(control_ + offset).match_empty_or_deleted();
+      if (mask != 0) {
+        return offset + flat_lookup_lowest_bit(mask);
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Grows the table when it is over half full, otherwise rebuilds it at the
+  // same capacity to drop tombstones.
+  DINGO_NOINLINE void rehash() {
+    const std::size_t capacity =
+        capacity_ == 0 ? flat_lookup_group_width
+        : size_ * 2 >= capacity_ ? capacity_ * 2
+                                 : capacity_;
+
+    auto *control =
+        std::allocator_traits<control_allocator>::allocate(control_allocator_,
+                                                           capacity);
+    Key *keys = nullptr;
+    Mapped *mapped = nullptr;
+    try {
+      keys = std::allocator_traits<key_allocator>::allocate(key_allocator_,
+                                                            capacity);
+      mapped = std::allocator_traits<mapped_allocator>::allocate(
+          mapped_allocator_, capacity);
+    } catch (...) {
+      if (keys != nullptr) {
+        std::allocator_traits<key_allocator>::deallocate(key_allocator_, keys,
+                                                         capacity);
+      }
+      std::allocator_traits<control_allocator>::deallocate(control_allocator_,
+                                                           control, capacity);
+      throw;
+    }
+    for (std::size_t i = 0; i < capacity; ++i) {
+      control[i] = static_cast<std::int8_t>(flat_lookup_control::empty);
+    }
+
+    auto *old_control = std::exchange(control_, control);
+    auto *old_keys = std::exchange(keys_, keys);
+    auto *old_mapped = std::exchange(mapped_, mapped);
+    const auto old_capacity = std::exchange(capacity_, capacity);
+    growth_left_ = growth_limit(capacity) - size_;
+
+    for (std::size_t i = 0; i < old_capacity; ++i) {
+      if (old_control[i] >= 0) {
+        const auto hash = hash_of(old_keys[i]);
+        const std::size_t slot = find_insert_slot(hash);
+        ::new (static_cast<void *>(keys_ + slot)) Key(std::move(old_keys[i]));
+        ::new (static_cast<void *>(mapped_ + slot))
+            Mapped(std::move(old_mapped[i]));
+        control_[slot] = fragment_of(hash);
+      }
+    }
+    release(old_control, old_keys, old_mapped, old_capacity);
+  }
+
+  void release(std::int8_t *control, Key *keys, Mapped *mapped,
+               std::size_t capacity) {
+    if (control == nullptr) {
+      return;
+    }
+    for (std::size_t i = 0; i < capacity; ++i) {
+      if (control[i] >= 0) {
+        keys[i].~Key();
+        mapped[i].~Mapped();
+      }
+    }
+    std::allocator_traits<mapped_allocator>::deallocate(mapped_allocator_,
+                                                        mapped, capacity);
+    std::allocator_traits<key_allocator>::deallocate(key_allocator_, keys,
+                                                     capacity);
+    std::allocator_traits<control_allocator>::deallocate(control_allocator_,
+                                                         control, capacity);
+  }
+
+  control_allocator control_allocator_;
+  key_allocator key_allocator_;
+  mapped_allocator mapped_allocator_;
+  std::int8_t *control_ = nullptr;
+  Key *keys_ = nullptr;
+  Mapped *mapped_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+  std::size_t growth_left_ = 0;
+};
+
+template <typename Key, typename Value, typename Cardinality,
+          typename Allocator>
+class flat_unordered_lookup_storage;
+
+template <typename Key, typename Value, typename Allocator>
+class flat_unordered_lookup_storage<Key, Value, ::dingo::one, Allocator> {
+  using table_type = flat_lookup_table<Key, Value, Allocator>;
+
+public:
+  class iterator {
+  public:
+    iterator() = default;
+
+    Value &operator*() const { return table_->mapped(slot_); }
+
+    bool operator==(const iterator &other) const {
+      return slot_ == other.slot_;
+    }
+
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    friend class flat_unordered_lookup_storage;
+
+    iterator(table_type *table, std::size_t slot)
+        : table_(table), slot_(slot) {}
+
+    table_type *table_ = nullptr;
+    std::size_t slot_ = table_type::npos;
+  };
+
+  class const_iterator {
+  public:
+    const_iterator() = default;
+
+    const Value &operator*() const { return table_->mapped(slot_); }
+
+    bool operator==(const const_iterator &other) const {
+      return slot_ == other.slot_;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class flat_unordered_lookup_storage;
+
+    const_iterator(const table_type *table, std::size_t slot)
+        : table_(table), slot_(slot) {}
+
+    const table_type *table_ = nullptr;
+    std::size_t slot_ = table_type::npos;
+  };
+
+  explicit flat_unordered_lookup_storage(Allocator &allocator)
+      : table_(allocator) {}
+
+  iterator find(const Key &key) { return iterator(&table_, table_.find(key)); }
+
+  const_iterator find(const Key &key) const {
+    return const_iterator(&table_, table_.find(key));
+  }
+
+  iterator end() { return iterator(); }
+  const_iterator end() const { return const_iterator(); }
+
+  template <typename Inserted>
+  std::pair<iterator, bool> try_emplace(const Key &key, Inserted &&value) {
+    auto [slot, inserted] =
+        table_.try_emplace(key, std::forward<Inserted>(value));
+    return {iterator(&table_, slot), inserted};
+  }
+
+  void erase(iterator handle) {
+    if (handle.slot_ != table_type::npos) {
+      table_.erase(handle.slot_);
+    }
+  }
+
+  template <typename Fn> void for_each_value(Fn &&fn) { table_.for_each(fn); }
+
+private:
+  table_type table_;
+};
+
+template <typename Key, typename Value, typename Allocator>
+class flat_unordered_lookup_storage<Key, Value, ::dingo::many, Allocator> {
+  using mapped_allocator = lookup_storage_allocator_t<Value, Allocator>;
+  using bucket_type = std::vector<Value, mapped_allocator>;
+  using table_type = flat_lookup_table<Key, bucket_type, Allocator>;
+
+public:
+  class iterator {
+  public:
+    iterator() = default;
+
+    Value &operator*() const { return *it_; }
+
+    iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    bool operator==(const iterator &other) const {
+      return slot_ == other.slot_ && (is_end() || it_ == other.it_);
+    }
+
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    friend class flat_unordered_lookup_storage;
+
+    iterator(std::size_t slot, typename bucket_type::iterator it)
+        : slot_(slot), it_(it) {}
+
+    bool is_end() const { return slot_ == table_type::npos; }
+
+    std::size_t slot_ = table_type::npos;
+    typename bucket_type::iterator it_{};
+  };
+
+  class const_iterator {
+  public:
+    const_iterator() = default;
+
+    const Value &operator*() const { return *it_; }
+
+    const_iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return slot_ == other.slot_ && (is_end() || it_ == other.it_);
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class flat_unordered_lookup_storage;
+
+    const_iterator(std::size_t slot, typename bucket_type::const_iterator it)
+        : slot_(slot), it_(it) {}
+
+    bool is_end() const { return slot_ == table_type::npos; }
+
+    std::size_t slot_ = table_type::npos;
+    typename bucket_type::const_iterator it_{};
+  };
+
+  explicit flat_unordered_lookup_storage(Allocator &allocator)
+      : table_(allocator),
+        mapped_allocator_(
+            make_lookup_storage_allocator<mapped_allocator>(allocator)) {}
+
+  iterator find(const Key &key) {
+    const auto range = equal_range(key);
+    return range.first == range.second ? end() : range.first;
+  }
+
+  const_iterator find(const Key &key) const {
+    const auto range = equal_range(key);
+    return range.first == range.second ? end() : range.first;
+  }
+
+  iterator end() { return iterator(); }
+  const_iterator end() const { return const_iterator(); }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    const auto slot = table_.find(key);
+    if (slot == table_type::npos) {
+      return {end(), end()};
+    }
+    auto &bucket = table_.mapped(slot);
+    return {iterator(slot, bucket.begin()), iterator(slot, bucket.end())};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+    const auto slot = table_.find(key);
+    if (slot == table_type::npos) {
+      return {end(), end()};
+    }
+    const auto &bucket = table_.mapped(slot);
+    return {const_iterator(slot, bucket.begin()),
+            const_iterator(slot, bucket.end())};
+  }
+
+  template <typename Inserted>
+  iterator emplace(const Key &key, Inserted &&value) {
+    const auto slot = table_.try_emplace(key, mapped_allocator_).first;
+    auto &bucket = table_.mapped(slot);
+    try {
+      bucket.emplace_back(std::forward<Inserted>(value));
+    } catch (...) {
+      if (bucket.empty()) {
+        table_.erase(slot);
+      }
+      throw;
+    }
+    auto it = bucket.end();
+    --it;
+    return iterator(slot, it);
+  }
+
+  void erase(iterator handle) {
+    auto &bucket = table_.mapped(handle.slot_);
+    bucket.erase(handle.it_);
+    if (bucket.empty()) {
+      table_.erase(handle.slot_);
+    }
+  }
+
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    table_.for_each([&](auto &bucket) {
+      for (auto &value : bucket) {
+        fn(value);
+      }
+    });
+  }
+
+private:
+  table_type table_;
+  mapped_allocator mapped_allocator_;
+};
+
+} // namespace detail
+
+// Open-addressing hash lookup. `one` keeps keys and values in flat arrays
+// probed sixteen control bytes at a time; `many` maps each key to a
+// contiguous bucket of values.
+struct flat_unordered {
+  template <typename Key, typename Value, typename Cardinality,
+            typename Allocator>
+  using storage =
+      detail::flat_unordered_lookup_storage<Key, Value, Cardinality, Allocator>;
+};
+
+} // namespace dingo
@@ -12,7 +12,10 @@
 #include <dingo/lookup/array.h>
 #include <dingo/lookup/base.h>
 #include <dingo/lookup/collection.h>
+#include <dingo/lookup/dense.h>
+#include <dingo/lookup/flat_unordered.h>
 #include <dingo/lookup/ordered.h>
+#include <dingo/lookup/sorted.h>
 #include <dingo/lookup/unordered.h>
 #include <dingo/type/normalized_type.h>
 #include <dingo/type/type_list.h>
@@ -58,6 +58,28 @@ lookup_singular_result<Value> lookup_find_singular(Backend &backend,
   }
 }
 
+template <typename Backend, typename Fn, typename = void>
+struct has_lookup_for_each_value : std::false_type {};
+
+template <typename Backend, typename Fn>
+struct has_lookup_for_each_value<
+    Backend, Fn,
+    std::void_t<decltype(std::declval<Backend &>().for_each_value(
+        std::declval<Fn &>()))>> : std::true_type {};
+
+// Visits every value of a backend. Standard containers are walked through
+// their iterators; custom backends provide for_each_value().
+template <typename Backend, typename Fn>
+void lookup_for_each_value(Backend &backend, Fn &fn) {
+  if constexpr (has_lookup_for_each_value<Backend, Fn>::value) {
+    backend.for_each_value(fn);
+  } else {
+    for (auto it = backend.begin(); it != backend.end(); ++it) {
+      fn(lookup_iterator_value(it));
+    }
+  }
+}
+
 template <typename LookupEntry, typename Backend, typename Key, typename Fn>
 std::size_t lookup_for_each(Backend &backend, const Key &key, Fn &&fn) {
   if constexpr (std::is_same_v<
@@ -0,0 +1,280 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/lookup/storage.h>
+#include <dingo/lookup/tags.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dingo {
+namespace detail {
+
+// Lower bound without data-dependent branches: each step selects the next
+// half with a conditional move, so the loop runs log2(size) times regardless
+// of the key.
+template <typename Key>
+std::size_t sorted_lookup_lower_bound(const Key *keys, std::size_t size,
+                                      const Key &key) {
+  if (size == 0) {
+    return 0;
+  }
+  const Key *base = keys;
+  while (size > 1) {
+    const std::size_t half = size / 2;
+    base = std::less<Key>()(base[half], key) ? base + half : base;
+    size -= half;
+  }
+  return static_cast<std::size_t>(base - keys) +
+         static_cast<std::size_t>(std::less<Key>()(*base, key));
+}
+
+// Keys and values are kept in separate contiguous arrays. Rows inserted by a
+// registration are appended to an unsorted tail that lookups scan linearly,
+// after a binary search over the sorted prefix. commit() merges the tail into
+// the prefix once it holds about the square root of all rows, so registering
+// n rows one by one costs O(n sqrt(n)) instead of a full merge per row.
+template <typename Key, typename Value, typename Cardinality,
+          typename Allocator>
+class sorted_lookup_storage {
+  using key_allocator = lookup_storage_allocator_t<Key, Allocator>;
+  using value_allocator = lookup_storage_allocator_t<Value, Allocator>;
+  using index_allocator = lookup_storage_allocator_t<std::size_t, Allocator>;
+  using key_vector = std::vector<Key, key_allocator>;
+  using value_vector = std::vector<Value, value_allocator>;
+  using index_vector = std::vector<std::size_t, index_allocator>;
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  template <typename Owner, typename Reference> class basic_iterator {
+  public:
+    basic_iterator() = default;
+
+    Reference operator*() const { return owner_->values_[position_]; }
+
+    basic_iterator &operator++() {
+      position_ = owner_->next(position_, sorted_last_, key_position_);
+      return *this;
+    }
+
+    bool operator==(const basic_iterator &other) const {
+      return position_ == other.position_;
+    }
+
+    bool operator!=(const basic_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class sorted_lookup_storage;
+
+    basic_iterator(Owner *owner, std::size_t position, std::size_t sorted_last,
+                   std::size_t key_position)
+        : owner_(owner), position_(position), sorted_last_(sorted_last),
+          key_position_(key_position) {}
+
+    Owner *owner_ = nullptr;
+    std::size_t position_ = npos;
+    // Rows for a key form the sorted range [position, sorted_last) followed by
+    // matching rows in the unsorted tail.
+    std::size_t sorted_last_ = 0;
+    std::size_t key_position_ = 0;
+  };
+
+public:
+  using iterator = basic_iterator<sorted_lookup_storage, Value &>;
+  using const_iterator =
+      basic_iterator<const sorted_lookup_storage, const Value &>;
+
+  explicit sorted_lookup_storage(Allocator &allocator)
+      : keys_(make_lookup_storage_allocator<key_allocator>(allocator)),
+        values_(make_lookup_storage_allocator<value_allocator>(allocator)),
+        index_allocator_(
+            make_lookup_storage_allocator<index_allocator>(allocator)) {}
+
+  iterator find(const Key &key) { return first<iterator>(this, key); }
+  const_iterator find(const Key &key) const {
+    return first<const_iterator>(this, key);
+  }
+
+  iterator end() { return iterator(); }
+  const_iterator end() const { return const_iterator(); }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return {find(key), end()};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+    return {find(key), end()};
+  }
+
+  template <typename Inserted, typename C = Cardinality,
+            typename = std::enable_if_t<std::is_same_v<C, ::dingo::one>>>
+  std::pair<iterator, bool> try_emplace(const Key &key, Inserted &&value) {
+    auto it = find(key);
+    if (it != end()) {
+      return {it, false};
+    }
+    return {append(key, std::forward<Inserted>(value)), true};
+  }
+
+  template <typename Inserted, typename C = Cardinality,
+            typename = std::enable_if_t<std::is_same_v<C, ::dingo::many>>>
+  iterator emplace(const Key &key, Inserted &&value) {
+    return append(key, std::forward<Inserted>(value));
+  }
+
+  void erase(iterator handle) {
+    const auto position = handle.position_;
+    keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(position));
+    values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(position));
+    if (position < sorted_) {
+      --sorted_;
+    }
+  }
+
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    for (auto &value : values_) {
+      fn(value);
+    }
+  }
+
+  void commit() noexcept {
+    const auto pending = keys_.size() - sorted_;
+    if (pending == 0 || pending * pending < keys_.size()) {
+      return;
+    }
+    try {
+      merge_pending();
+    } catch (...) {
+      // Lookups keep scanning the unsorted tail until the next commit.
+    }
+  }
+
+private:
+  static bool equivalent(const Key &lhs, const Key &rhs) {
+    return !std::less<Key>()(lhs, rhs) && !std::less<Key>()(rhs, lhs);
+  }
+
+  template <typename Iterator, typename Owner>
+  static Iterator first(Owner *owner, const Key &key) {
+    const auto sorted = owner->sorted_;
+    const auto position =
+        sorted_lookup_lower_bound(owner->keys_.data(), sorted, key);
+    if (position != sorted && equivalent(owner->keys_[position], key)) {
+      auto last = position + 1;
+      if constexpr (std::is_same_v<Cardinality, ::dingo::many>) {
+        while (last != sorted && equivalent(owner->keys_[last], key)) {
+          ++last;
+        }
+      }
+      return Iterator(owner, position, last, position);
+    }
+    const auto pending = owner->find_pending(sorted, key);
+    return pending == npos ? Iterator() : Iterator(owner, pending, 0, pending);
+  }
+
+  std::size_t find_pending(std::size_t position, const Key &key) const {
+    for (; position < keys_.size(); ++position) {
+      if (equivalent(keys_[position], key)) {
+        return position;
+      }
+    }
+    return npos;
+  }
+
+  std::size_t next(std::size_t position, std::size_t sorted_last,
+                   std::size_t key_position) const {
+    if constexpr (std::is_same_v<Cardinality, ::dingo::one>) {
+      return npos;
+    } else {
+      if (++position < sorted_last) {
+        return position;
+      }
+      return find_pending(std::max(position, sorted_), keys_[key_position]);
+    }
+  }
+
+  template <typename Inserted>
+  iterator append(const Key &key, Inserted &&value) {
+    keys_.push_back(key);
+    try {
+      values_.emplace_back(std::forward<Inserted>(value));
+    } catch (...) {
+      keys_.pop_back();
+      throw;
+    }
+    const auto position = keys_.size() - 1;
+    return iterator(this, position, 0, position);
+  }
+
+  // Stable merge keeps rows of equal keys in insertion order. Keys are copied
+  // before any value is moved, so a throwing key copy leaves the storage
+  // untouched.
+  void merge_pending() {
+    const auto size = keys_.size();
+    index_vector pending(index_allocator_);
+    pending.reserve(size - sorted_);
+    for (auto position = sorted_; position < size; ++position) {
+      pending.push_back(position);
+    }
+    std::stable_sort(pending.begin(), pending.end(),
+                     [this](std::size_t lhs, std::size_t rhs) {
+                       return std::less<Key>()(keys_[lhs], keys_[rhs]);
+                     });
+
+    index_vector order(index_allocator_);
+    order.reserve(size);
+    std::size_t left = 0;
+    auto right = pending.begin();
+    while (left != sorted_ || right != pending.end()) {
+      const bool take_left =
+          right == pending.end() ||
+          (left != sorted_ && !std::less<Key>()(keys_[*right], keys_[left]));
+      order.push_back(take_left ? left++ : *right++);
+    }
+
+    key_vector keys(keys_.get_allocator());
+    value_vector values(values_.get_allocator());
+    keys.reserve(size);
+    values.reserve(size);
+    for (auto position : order) {
+      keys.push_back(std::move_if_noexcept(keys_[position]));
+    }
+    for (auto position : order) {
+      values.push_back(std::move(values_[position]));
+    }
+
+    keys_.swap(keys);
+    values_.swap(values);
+    sorted_ = size;
+  }
+
+  key_vector keys_;
+  value_vector values_;
+  index_allocator index_allocator_;
+  std::size_t sorted_ = 0;
+};
+
+} // namespace detail
+
+// Sorted-array lookup for registries that are populated up front and then
+// only read. Rows are merged into place when the registration commits.
+struct sorted {
+  template <typename Key, typename Value, typename Cardinality,
+            typename Allocator>
+  using storage =
+      detail::sorted_lookup_storage<Key, Value, Cardinality, Allocator>;
+};
+
+} // namespace dingo
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace dingo::detail {
 
@@ -29,4 +31,18 @@ Storage make_lookup_storage(Allocator &allocator) {
   return lookup_storage_factory<Storage, Allocator>::make(allocator);
 }
 
+// Backends exposing `commit()` are notified when the registration transaction
+// that inserted into them commits.
+template <typename Storage, typename = void>
+struct has_lookup_storage_commit : std::false_type {};
+
+template <typename Storage>
+struct has_lookup_storage_commit<
+    Storage, std::void_t<decltype(std::declval<Storage &>().commit())>>
+    : std::true_type {};
+
+template <typename Storage>
+inline constexpr bool has_lookup_storage_commit_v =
+    has_lookup_storage_commit<Storage>::value;
+
 } // namespace dingo::detail
@@ -18,10 +18,20 @@
 namespace dingo {
 
 template <typename T> struct arena_allocator_traits : std::allocator_traits<T> {
-  static constexpr intptr_t page_size() { return 1 << 12; }
+  static constexpr intptr_t page_size(const T &) { return 1 << 12; }
   static constexpr intptr_t header_size() { return sizeof(uintptr_t) * 2; }
 };
 
+// Sizes of the blocks an arena requests from its allocator. The first block
+// has `BlockSize` bytes and each following one doubles it until it reaches
+// `MaxBlockSize`. Requests that do not fit get a block of their own size.
+template <std::size_t BlockSize, std::size_t MaxBlockSize = BlockSize>
+struct arena_growth {
+  static_assert(BlockSize > 0 && BlockSize <= MaxBlockSize);
+  static constexpr std::size_t block_size = BlockSize;
+  static constexpr std::size_t max_block_size = MaxBlockSize;
+};
+
 template <typename Allocator = std::allocator<uint8_t>>
 class arena
     : arena_allocator_traits<Allocator>::template rebind_alloc<uint8_t> {
@@ -37,7 +47,8 @@ class arena
   };
 
   block *block_head_ = nullptr;
-  intptr_t initial_block_size_ = 0;
+  uint32_t block_size_ = 0;
+  uint32_t max_block_size_ = 0;
 
   static intptr_t block_begin(block *head) {
     return reinterpret_cast<intptr_t>(head) + sizeof(block);
@@ -47,23 +58,21 @@ class arena
     return reinterpret_cast<intptr_t>(head) + head->size;
   }
 
-  static intptr_t checked_block_size(std::size_t block_size) {
-    assert(block_size <=
-           static_cast<std::size_t>(std::numeric_limits<intptr_t>::max()));
-    return static_cast<intptr_t>(block_size);
+  static uint32_t checked_block_size(std::size_t block_size) {
+    assert(block_size <= std::numeric_limits<uint32_t>::max());
+    return static_cast<uint32_t>(block_size);
   }
 
   bool request_block(intptr_t bytes) {
-    assert(initial_block_size_ > 0);
+    assert(block_size_ > 0);
     if (bytes > std::numeric_limits<intptr_t>::max() -
                     static_cast<intptr_t>(sizeof(block))) {
       return false;
     }
 
-    intptr_t size =
-        std::max<intptr_t>(initial_block_size_, sizeof(block) + bytes);
+    intptr_t size = std::max<intptr_t>(block_size_, sizeof(block) + bytes);
     const auto header_size = allocator_traits_type::header_size();
-    const auto page_size = allocator_traits_type::page_size();
+    const auto page_size = allocator_traits_type::page_size(*this);
     assert((page_size & (page_size - 1)) == 0);
     if (size > page_size / 2) {
       if (size > std::numeric_limits<intptr_t>::max() - header_size -
@@ -79,6 +88,8 @@ class arena
     head->size = size;
     head->owned = true;
     push_block(head);
+    block_size_ = static_cast<uint32_t>(
+        std::min<uint64_t>(uint64_t{block_size_} * 2, max_block_size_));
     return true;
   }
 
@@ -128,13 +139,23 @@ public:
     intptr_t ptr;
   };
 
+  // Bytes taken from the start of every block, including a caller's buffer.
+  static constexpr std::size_t block_header_size() { return sizeof(block); }
+
   arena(std::size_t block_size)
-      : initial_block_size_(checked_block_size(block_size)) {}
+      : block_size_(checked_block_size(block_size)),
+        max_block_size_(block_size_) {}
 
   template <typename AllocatorT>
   arena(std::size_t block_size, const AllocatorT &alloc)
-      : allocator_type(alloc),
-        initial_block_size_(checked_block_size(block_size)) {}
+      : allocator_type(alloc), block_size_(checked_block_size(block_size)),
+        max_block_size_(block_size_) {}
+
+  template <std::size_t BlockSize, std::size_t MaxBlockSize,
+            typename AllocatorT>
+  arena(arena_growth<BlockSize, MaxBlockSize>, const AllocatorT &alloc)
+      : allocator_type(alloc), block_size_(checked_block_size(BlockSize)),
+        max_block_size_(checked_block_size(MaxBlockSize)) {}
 
   template <typename T, std::size_t N>
   arena(T (&buffer)[N], std::size_t block_size = N * sizeof(T))
@@ -185,6 +206,18 @@ public:
 
   void deallocate(void *, std::size_t) {}
 
+  // Makes the current block hold at least `size` more bytes, requesting a
+  // block of that size if it does not.
+  bool reserve(std::size_t size) {
+    if (size > static_cast<std::size_t>(std::numeric_limits<intptr_t>::max()))
+      return false;
+    intptr_t bytes = static_cast<intptr_t>(size);
+    if (block_head_ != nullptr &&
+        block_end(block_head_) - block_head_->ptr >= bytes)
+      return true;
+    return request_block(bytes);
+  }
+
   checkpoint mark() const noexcept {
     return checkpoint{block_head_,
                       block_head_ != nullptr ? block_head_->ptr : intptr_t{0}};
@@ -197,6 +230,34 @@ public:
     }
   }
 
+  // Bytes allocated since the checkpoint, including alignment padding.
+  std::size_t used_since(checkpoint point) const noexcept {
+    std::size_t used = 0;
+    auto head = block_head_;
+    for (; head != point.head; head = head->next) {
+      assert(head != nullptr);
+      used += static_cast<std::size_t>(head->ptr - block_begin(head));
+    }
+    if (head != nullptr) {
+      used += static_cast<std::size_t>(head->ptr - point.ptr);
+    }
+    return used;
+  }
+
+  // Bytes allocated since the arena was created.
+  std::size_t used() const noexcept {
+    return used_since(checkpoint{nullptr, 0});
+  }
+
+  // Bytes of all blocks, including the initial buffer and block headers.
+  std::size_t reserved() const noexcept {
+    std::size_t reserved = 0;
+    for (auto head = block_head_; head != nullptr; head = head->next) {
+      reserved += static_cast<std::size_t>(head->size);
+    }
+    return reserved;
+  }
+
   void reset() { deallocate_blocks(nullptr); }
 };
 
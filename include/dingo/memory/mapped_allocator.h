@@ -0,0 +1,173 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/detail/virtual_memory.h>
+#include <dingo/memory/arena_allocator.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace dingo {
+enum class mapped_pages {
+  // Pages of the default system size.
+  normal,
+  // Asks the system to back the region with transparent huge pages where it
+  // supports them.
+  huge
+};
+
+// A contiguous range of virtual memory reserved once and committed as it is
+// used. Allocations bump a pointer; releasing the most recent allocation
+// returns its space, so an arena rewinding its blocks reuses the range.
+// The whole range is released with the region.
+class mapped_region {
+public:
+  explicit mapped_region(std::size_t size,
+                         mapped_pages pages = mapped_pages::normal)
+      : page_size_(granularity(pages)), size_(round_up(size, page_size_)) {
+    // Huge pages need the range aligned to their size, so reserve one more
+    // and start at the first boundary inside.
+    mapped_size_ = pages == mapped_pages::huge ? size_ + page_size_ : size_;
+    base_ = detail::virtual_memory_reserve(mapped_size_);
+    if (!base_)
+      throw std::bad_alloc();
+    begin_ = reinterpret_cast<uint8_t *>(
+        round_up(static_cast<std::size_t>(reinterpret_cast<uintptr_t>(base_)),
+                 page_size_));
+    if (pages == mapped_pages::huge)
+      huge_pages_ = detail::virtual_memory_advise_huge(begin_, size_);
+    top_ = committed_ = begin_;
+  }
+
+  ~mapped_region() { detail::virtual_memory_release(base_, mapped_size_); }
+
+  mapped_region(const mapped_region &) = delete;
+  mapped_region &operator=(const mapped_region &) = delete;
+
+  void *allocate(std::size_t size, std::size_t alignment) {
+    assert((alignment & (alignment - 1)) == 0);
+    auto offset = round_up(static_cast<std::size_t>(top_ - begin_), alignment);
+    if (offset > size_ || size_ - offset < size)
+      throw std::bad_alloc();
+    auto *ptr = begin_ + offset;
+    if (ptr + size > committed_) {
+      auto end = round_up(offset + size, page_size_);
+      if (!detail::virtual_memory_commit(
+              committed_, static_cast<std::size_t>(begin_ + end - committed_)))
+        throw std::bad_alloc();
+      committed_ = begin_ + end;
+    }
+    top_ = ptr + size;
+    return ptr;
+  }
+
+  void deallocate(void *ptr, std::size_t size) noexcept {
+    auto *bytes = static_cast<uint8_t *>(ptr);
+    assert(bytes >= begin_ && bytes + size <= top_);
+    if (bytes + size == top_)
+      top_ = bytes;
+  }
+
+  // Bytes of the reserved range and of its committed prefix.
+  std::size_t reserved() const noexcept { return size_; }
+  std::size_t committed() const noexcept {
+    return static_cast<std::size_t>(committed_ - begin_);
+  }
+
+  // Step in which the range is committed; the huge page size for huge
+  // regions.
+  std::size_t page_size() const noexcept { return page_size_; }
+
+  // Whether the system accepted the request for transparent huge pages. The
+  // region still works with normal pages when it did not.
+  bool huge_pages() const noexcept { return huge_pages_; }
+
+private:
+  static std::size_t round_up(std::size_t value, std::size_t alignment) {
+    assert(value <= std::numeric_limits<std::size_t>::max() - alignment);
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  // Huge page regions start on a 2MB boundary and are committed in 2MB steps
+  // so that each step can be backed by one huge page.
+  static std::size_t granularity(mapped_pages pages) {
+    return pages == mapped_pages::huge ? std::size_t(2) << 20
+                                       : detail::virtual_memory_page_size();
+  }
+
+  std::size_t page_size_;
+  std::size_t size_;
+  std::size_t mapped_size_ = 0;
+  void *base_ = nullptr;
+  uint8_t *begin_ = nullptr;
+  uint8_t *top_ = nullptr;
+  uint8_t *committed_ = nullptr;
+  bool huge_pages_ = false;
+};
+
+// Allocator drawing from a mapped_region, meant as the upstream of the
+// container arena for very large registries.
+template <typename T> class mapped_allocator {
+  template <typename U> friend class mapped_allocator;
+  mapped_region *region_ = nullptr;
+
+public:
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = mapped_allocator<U>;
+  };
+
+  mapped_allocator(mapped_region &region) noexcept : region_(&region) {}
+
+  mapped_region &region() const noexcept { return *region_; }
+
+  template <typename U>
+  mapped_allocator(const mapped_allocator<U> &other) noexcept
+      : region_(other.region_) {}
+
+  T *allocate(std::size_t n) {
+    if (std::numeric_limits<std::size_t>::max() / sizeof(T) < n)
+      throw std::bad_alloc();
+    return static_cast<T *>(region_->allocate(
+        sizeof(T) * n, (std::max)(alignof(T), alignof(std::max_align_t))));
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    region_->deallocate(ptr, sizeof(T) * n);
+  }
+
+  template <typename U>
+  bool operator==(const mapped_allocator<U> &other) const noexcept {
+    return region_ == other.region_;
+  }
+
+  template <typename U>
+  bool operator!=(const mapped_allocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+// The region has no per-allocation header, so arena blocks rounded to the
+// region's pages fill them exactly.
+template <typename T>
+struct arena_allocator_traits<mapped_allocator<T>>
+    : std::allocator_traits<mapped_allocator<T>> {
+  static intptr_t page_size(const mapped_allocator<T> &allocator) {
+    return static_cast<intptr_t>(allocator.region().page_size());
+  }
+  static constexpr intptr_t header_size() { return 0; }
+};
+} // namespace dingo
@@ -60,6 +60,16 @@ public:
 
   bool empty() const noexcept { return tail_ == nullptr; }
 
+  // Walks the list, O(n).
+  std::size_t size() const noexcept {
+    std::size_t count = 0;
+    for (auto *current = tail_; current != nullptr;
+         current = current->previous) {
+      ++count;
+    }
+    return count;
+  }
+
   T &top() noexcept {
     assert(tail_ != nullptr);
     return tail_->value;
@@ -153,6 +163,8 @@ public:
 
   checkpoint mark() const noexcept { return destructors_.mark(); }
 
+  std::size_t destructor_count() const noexcept { return destructors_.size(); }
+
   void destroy(Arena &arena) noexcept {
     destroy(arena, typename destructor_journal::checkpoint{nullptr});
   }
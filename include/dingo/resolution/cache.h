@@ -22,6 +22,10 @@ template <typename T> const void *key() noexcept {
   return std::addressof(type_key<T>);
 }
 
+// Key of the entry of a binding whose addresses are not stable. No request
+// key compares equal to it, so the entry is never filled.
+inline constexpr unsigned char uncached_key = 0;
+
 struct sink {
   void *state = nullptr;
   void (*publish)(void *, void *) = nullptr;
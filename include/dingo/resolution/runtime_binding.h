@@ -10,9 +10,11 @@
 #include <dingo/core/config.h>
 
 #include <dingo/core/binding_resolution.h>
+#include <dingo/memory/tagged_ptr.h>
 #include <dingo/resolution/runtime_binding_interface.h>
 #include <dingo/runtime/container_runtime.h>
 #include <dingo/runtime/context.h>
+#include <dingo/runtime/observer.h>
 #include <dingo/type/rebind_type.h>
 
 #include <cassert>
@@ -50,13 +52,61 @@ template <typename Container>
 inline constexpr bool runtime_resolution_requires_container_v =
     runtime_resolution_requires_container<Container>::value;
 
-template <bool Stable>
-class runtime_binding_base : private cache::state<Stable> {
-protected:
-  cache::entry *binding_cache_slot() noexcept { return cache_state::slot(); }
+// Points to the owner of a binding state until the binding creates its own
+// containers. The pointer is then retagged to a record keeping the owner next
+// to them, so bindings without containers carry a single pointer.
+template <typename Owner, typename Containers> class runtime_binding_link {
+  struct record {
+    explicit record(Owner *record_owner) : owner(record_owner) {}
+
+    Owner *owner;
+    Containers containers;
+  };
+
+public:
+  explicit runtime_binding_link(Owner *owner) : link_(owner) {}
+
+  Owner &owner() const {
+    auto *owner = link_.tag() ? get_record()->owner : link_.get();
+    assert(owner != nullptr);
+    return *owner;
+  }
+
+  Containers *containers() const {
+    return link_.tag() ? &get_record()->containers : nullptr;
+  }
+
+  template <typename Runtime> Containers &containers(Runtime &runtime) {
+    if (!link_.tag()) {
+      attach(&runtime.template construct<record>(link_.get()));
+    }
+    return get_record()->containers;
+  }
+
+  template <bool TrackRollback, typename Context>
+  Containers &containers_in(Context &context) {
+    if (!link_.tag()) {
+      auto *owner = link_.get();
+      attach(&context.template construct<record>(persistent_scope, owner));
+      if constexpr (TrackRollback) {
+        context.on_rollback(
+            [this, owner]() noexcept { link_ = tagged_ptr<Owner>(owner); });
+      }
+    }
+    return get_record()->containers;
+  }
 
 private:
-  using cache_state = cache::state<Stable>;
+  record *get_record() const {
+    assert(link_.tag());
+    return reinterpret_cast<record *>(link_.get());
+  }
+
+  void attach(record *created) noexcept {
+    link_ = tagged_ptr<Owner>(reinterpret_cast<Owner *>(created), 1);
+  }
+
+  tagged_ptr<Owner> link_;
 };
 
 } // namespace detail
@@ -64,8 +114,7 @@ private:
 template <typename Owner, typename InstanceContainer, typename Storage,
           typename ResolutionContainer = InstanceContainer,
           typename RegistrationParent = typename Owner::parent_container_type>
-class runtime_binding_state : private detail::runtime_binding_base<
-                                  detail::cache::is_stable_storage_v<Storage>> {
+class runtime_binding_state {
 public:
   using owner_type = Owner;
   using container_type = InstanceContainer;
@@ -79,7 +128,7 @@ public:
 
   template <typename... Args>
   explicit runtime_binding_state(owner_type *owner, Args &&...args)
-      : owner_(owner), storage_(std::forward<Args>(args)...) {}
+      : link_(owner), storage_(std::forward<Args>(args)...) {}
 
   runtime_type &runtime() { return owner().runtime(); }
   parent_container_type *parent() {
@@ -93,42 +142,40 @@ public:
   }
   allocator_type &get_allocator() { return owner().get_allocator(); }
   Storage &storage() { return storage_; }
-  detail::cache::entry *cache_slot() noexcept {
-    return state_base::binding_cache_slot();
-  }
   InstanceContainer &container() {
-    if (!instance_container_) {
-      instance_container_ = construct_container<InstanceContainer>();
+    auto &containers = link_.containers(runtime());
+    if (!containers.instance) {
+      containers.instance = construct_container<InstanceContainer>();
     }
-    return *instance_container_;
+    return *containers.instance;
   }
 
   template <bool TrackRollback = true>
   ResolutionContainer &resolution_container(runtime_context_type &context) {
-    if (!resolution_container_) {
-      assert(resolution_container_ == nullptr);
+    auto &containers = link_.template containers_in<TrackRollback>(context);
+    if (!containers.resolution) {
       auto *created = construct_container<ResolutionContainer>(context);
       if constexpr (TrackRollback) {
         context.on_rollback(
-            [this]() noexcept { resolution_container_ = nullptr; });
+            [&containers]() noexcept { containers.resolution = nullptr; });
       }
-      resolution_container_ = created;
+      containers.resolution = created;
     }
-    return *resolution_container_;
+    return *containers.resolution;
   }
 
   template <bool TrackRollback = true>
   InstanceContainer &container(runtime_context_type &context) {
-    if (!instance_container_) {
-      assert(instance_container_ == nullptr);
+    auto &containers = link_.template containers_in<TrackRollback>(context);
+    if (!containers.instance) {
       auto *created = construct_container<InstanceContainer>(context);
       if constexpr (TrackRollback) {
         context.on_rollback(
-            [this]() noexcept { instance_container_ = nullptr; });
+            [&containers]() noexcept { containers.instance = nullptr; });
       }
-      instance_container_ = created;
+      containers.instance = created;
     }
-    return *instance_container_;
+    return *containers.instance;
   }
 
   template <bool TrackRollback = true, typename Fn>
@@ -138,13 +185,7 @@ public:
   }
 
 private:
-  using state_base =
-      detail::runtime_binding_base<detail::cache::is_stable_storage_v<Storage>>;
-
-  owner_type &owner() {
-    assert(owner_ != nullptr);
-    return *owner_;
-  }
+  owner_type &owner() { return link_.owner(); }
 
   template <typename T> T *construct_container(runtime_context_type &context) {
     return std::addressof(context.template construct<T>(
@@ -156,18 +197,19 @@ private:
         runtime().template construct<T>(parent(), get_allocator()));
   }
 
-  owner_type *owner_ = nullptr;
+  struct containers_type {
+    InstanceContainer *instance = nullptr;
+    ResolutionContainer *resolution = nullptr;
+  };
+
+  detail::runtime_binding_link<owner_type, containers_type> link_;
   Storage storage_;
-  InstanceContainer *instance_container_ = nullptr;
-  ResolutionContainer *resolution_container_ = nullptr;
 };
 
 template <typename Owner, typename InstanceContainer, typename Storage,
           typename RegistrationParent>
 class runtime_binding_state<Owner, InstanceContainer, Storage,
-                            InstanceContainer, RegistrationParent>
-    : private detail::runtime_binding_base<
-          detail::cache::is_stable_storage_v<Storage>> {
+                            InstanceContainer, RegistrationParent> {
 public:
   using owner_type = Owner;
   using container_type = InstanceContainer;
@@ -181,7 +223,7 @@ public:
 
   template <typename... Args>
   explicit runtime_binding_state(owner_type *owner, Args &&...args)
-      : owner_(owner), storage_(std::forward<Args>(args)...) {}
+      : link_(owner), storage_(std::forward<Args>(args)...) {}
 
   runtime_type &runtime() { return owner().runtime(); }
   parent_container_type *parent() {
@@ -195,28 +237,26 @@ public:
   }
   allocator_type &get_allocator() { return owner().get_allocator(); }
   Storage &storage() { return storage_; }
-  detail::cache::entry *cache_slot() noexcept {
-    return state_base::binding_cache_slot();
-  }
   InstanceContainer &container() {
-    if (!instance_container_) {
-      instance_container_ = construct_container<InstanceContainer>();
+    auto &containers = link_.containers(runtime());
+    if (!containers.instance) {
+      containers.instance = construct_container<InstanceContainer>();
     }
-    return *instance_container_;
+    return *containers.instance;
   }
 
   template <bool TrackRollback = true>
   InstanceContainer &container(runtime_context_type &context) {
-    if (!instance_container_) {
-      assert(instance_container_ == nullptr);
+    auto &containers = link_.template containers_in<TrackRollback>(context);
+    if (!containers.instance) {
       auto *created = construct_container<InstanceContainer>(context);
       if constexpr (TrackRollback) {
         context.on_rollback(
-            [this]() noexcept { instance_container_ = nullptr; });
+            [&containers]() noexcept { containers.instance = nullptr; });
       }
-      instance_container_ = created;
+      containers.instance = created;
     }
-    return *instance_container_;
+    return *containers.instance;
   }
 
   template <bool TrackRollback = true>
@@ -232,21 +272,16 @@ public:
       return fn(container<TrackRollback>(context));
     } else {
       (void)context;
-      if (instance_container_ != nullptr) {
-        return fn(*instance_container_);
+      auto *containers = link_.containers();
+      if (containers != nullptr && containers->instance != nullptr) {
+        return fn(*containers->instance);
       }
       return fn(*parent());
     }
   }
 
 private:
-  using state_base =
-      detail::runtime_binding_base<detail::cache::is_stable_storage_v<Storage>>;
-
-  owner_type &owner() {
-    assert(owner_ != nullptr);
-    return *owner_;
-  }
+  owner_type &owner() { return link_.owner(); }
 
   template <typename T> T *construct_container(runtime_context_type &context) {
     return std::addressof(context.template construct<T>(
@@ -258,9 +293,12 @@ private:
         runtime().template construct<T>(parent(), get_allocator()));
   }
 
-  owner_type *owner_ = nullptr;
+  struct containers_type {
+    InstanceContainer *instance = nullptr;
+  };
+
+  detail::runtime_binding_link<owner_type, containers_type> link_;
   Storage storage_;
-  InstanceContainer *instance_container_ = nullptr;
 };
 
 namespace detail {
@@ -396,6 +434,10 @@ public:
                                             cache_types>;
 
 private:
+  template <typename T = Container>
+  using observer_t = detail::container_observer_type_t<
+      typename T::container_traits_type>;
+
   template <typename T, typename Context, typename... Args>
   T &construct_conversion(construction_scope scope, Context &context,
                           Args &&...args) {
@@ -444,6 +486,8 @@ private:
   template <typename Context, typename Fn>
   decltype(auto) with_source(construction_scope scope, Context &context,
                              Fn &&fn) {
+    detail::construct_observation<observer_t<>> observation(
+        registered_type(), [this] { return constructs_instance(); });
     if constexpr (materialization_traits::can_retain_source) {
       if (materialization_traits::retains_source(get_storage())) {
         const bool reset_storage = should_reset_storage_on_failure();
@@ -506,6 +550,14 @@ private:
         ->reset_retained_source_runtime_artifacts();
   }
 
+  bool constructs_instance() {
+    if constexpr (detail::runtime_storage_can_reset<Storage>::value) {
+      return !get_storage().is_resolved();
+    } else {
+      return true;
+    }
+  }
+
   bool should_reset_storage_on_failure() {
     if constexpr (detail::runtime_storage_can_reset<Storage>::value) {
       return !get_storage().is_resolved();
@@ -549,14 +601,18 @@ public:
                                            detail::cache::sink cache) {
     auto &binding = static_cast<runtime_binding &>(erased);
     if constexpr (type_list_size_v<request_resolutions> == 0) {
-      (void)scope;
-      (void)cache;
+      if (is_warm_up_request(request)) {
+        return warm_up(binding, scope, context, request, cache);
+      }
       throw detail::make_type_not_convertible_exception(
           request.requested_type, registered_type(), context);
     } else {
       const auto resolution_index = detail::resolution_request_index(
           request_resolutions{}, request.requested_type);
       if (resolution_index == type_list_size_v<request_resolutions>) {
+        if (is_warm_up_request(request)) {
+          return warm_up(binding, scope, context, request, cache);
+        }
         throw detail::make_type_not_convertible_exception(
             request.requested_type, registered_type(), context);
       }
@@ -584,13 +640,57 @@ public:
 #pragma warning(pop)
 #endif
 
+  // Materializes a shared binding and publishes the address a `Type &`
+  // request would cache. Other storages are left untouched.
+  static resolved_address warm_up(runtime_binding &binding,
+                                  construction_scope scope,
+                                  runtime_context_type &context,
+                                  const request_type &request,
+                                  detail::cache::sink cache) {
+    const auto &warm_up =
+        static_cast<const warm_up_request<rtti_type> &>(request);
+    if constexpr (detail::is_warm_up_storage_v<typename Storage::tag_type>) {
+      if (warm_up.filter.accepts(describe_type<Type>())) {
+        using warm_up_type = Type &;
+        *warm_up.result = {true, describe_type<Type>(), nullptr};
+        const auto resolution_index = detail::resolution_request_index(
+            request_resolutions{}, describe_type<warm_up_type>());
+        if (resolution_index == type_list_size_v<request_resolutions>) {
+          (void)binding.resolve(scope, context);
+          return {nullptr, resolved_address::access_kind::borrow};
+        }
+
+        binding_activation activation{binding, scope};
+        auto result = binding.with_source(
+            scope, context, [&](auto &&source) -> resolved_address {
+              return detail::resolve_request_address_from_source<Storage>(
+                  scope, activation, context,
+                  std::forward<decltype(source)>(source), resolution_index,
+                  request_resolutions{}, describe_type<warm_up_type>(),
+                  registered_type());
+            });
+        if constexpr (Storage::conversions::is_stable) {
+          if (result.access == resolved_address::access_kind::borrow) {
+            warm_up.result->cache_key = detail::cache::key<warm_up_type>();
+            cache(result.address);
+          }
+        }
+        return result;
+      }
+    }
+    (void)binding;
+    (void)scope;
+    (void)context;
+    (void)cache;
+    return {nullptr, resolved_address::access_kind::borrow};
+  }
+
 public:
   template <typename... Args>
   runtime_binding(Args &&...args)
-      : interface_base(&runtime_binding::dispatch_request),
-        state_(std::forward<Args>(args)...) {
-    this->cache_slot(state().cache_slot());
-  }
+      : interface_base(&runtime_binding::dispatch_request,
+                       detail::cache::is_stable_storage_v<Storage>),
+        state_(std::forward<Args>(args)...) {}
 
   auto &get_container() { return state().container(); }
 
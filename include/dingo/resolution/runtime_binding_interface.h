@@ -9,10 +9,13 @@
 
 #include <dingo/core/config.h>
 #include <dingo/core/construction_scope.h>
+#include <dingo/core/warm_up.h>
 #include <dingo/resolution/cache.h>
 #include <dingo/type/rebind_type.h>
 #include <dingo/type/type_descriptor.h>
 
+#include <memory>
+
 namespace dingo {
 template <typename Allocator> class runtime_context;
 
@@ -23,6 +26,19 @@ template <typename RTTI> struct instance_request {
   type_descriptor requested_type;
 };
 
+// Asks a binding to materialize its shared instance for container.warm_up().
+// No binding resolves the tag type, so the request only reaches bindings
+// through their unsupported-request path.
+template <typename RTTI> struct warm_up_request : instance_request<RTTI> {
+  detail::warm_up_filter filter;
+  detail::warm_up_result *result;
+};
+
+template <typename RTTI>
+bool is_warm_up_request(const instance_request<RTTI> &request) {
+  return request.requested_type == describe_type<detail::warm_up_tag>();
+}
+
 template <typename T> struct request_lookup_type {
   using type = rebind_leaf_t<T, runtime_type>;
 };
@@ -69,7 +85,10 @@ public:
                                                 const request_type &,
                                                 detail::cache::sink);
 
-  detail::cache::entry *cache_slot() noexcept { return cache_slot_; }
+  detail::cache::entry *cache_slot() noexcept {
+    return cache_.key != std::addressof(detail::cache::uncached_key) ? &cache_
+                                                                     : nullptr;
+  }
 
   resolved_address resolve_request(construction_scope scope, Context &context,
                                    const request_type &request,
@@ -80,14 +99,17 @@ public:
 protected:
   // Runtime lookup is non-owning; transaction storage destroys concrete
   // bindings, so dispatch does not need a distinct virtual base per container.
-  explicit runtime_binding_interface(resolve_function resolve)
-      : resolve_(resolve) {}
+  // The cache entry lives here rather than in the binding state, so a lookup
+  // reads it without another indirection and each interface of a
+  // multi-interface registration caches its own request.
+  runtime_binding_interface(resolve_function resolve, bool cached)
+      : resolve_(resolve),
+        cache_{cached ? nullptr : std::addressof(detail::cache::uncached_key),
+               nullptr} {}
   ~runtime_binding_interface() = default;
 
-  void cache_slot(detail::cache::entry *slot) noexcept { cache_slot_ = slot; }
-
 private:
   resolve_function resolve_;
-  detail::cache::entry *cache_slot_ = nullptr;
+  detail::cache::entry cache_;
 };
 } // namespace dingo
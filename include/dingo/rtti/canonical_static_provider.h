@@ -0,0 +1,66 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/rtti/interned_table.h>
+#include <dingo/rtti/rtti.h>
+#include <dingo/type/type_descriptor.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dingo {
+namespace detail {
+// Names are copied so that ids outlive the shared library that interned them.
+using interned_type_name_table = interned_table<std::string>;
+
+DINGO_RTTI_INTERNED_TABLE_API inline interned_type_name_table &
+interned_type_names() {
+  static auto *table = new interned_type_name_table();
+  return *table;
+}
+
+// Types in anonymous namespaces and types local to functions are spelled the
+// same in every translation unit that declares them, so their names do not
+// identify them.
+constexpr bool is_canonical_type_name(std::string_view name) {
+  constexpr std::string_view ambiguous[] = {
+      "{anonymous}",           // GCC
+      "(anonymous namespace)", // Clang
+      "`anonymous namespace'", // MSVC
+      ")::",                   // GCC and Clang function-local types
+      "'::",                   // MSVC function-local types
+  };
+  for (auto marker : ambiguous) {
+    if (type_name_find(name, marker) != type_name_not_found) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace detail
+
+template <> class rtti<canonical_static_provider> {
+public:
+  using type_index = detail::interned_type_index;
+
+  // Each shared library canonicalizes a type once by its name; later calls
+  // read a local static.
+  template <typename T> static type_index get_type_index() {
+    static_assert(detail::is_canonical_type_name(raw_type_name<T>()),
+                  "canonical_static_provider identifies types by name; types "
+                  "in anonymous namespaces or local to functions are not "
+                  "unique by name");
+    static const uint32_t id =
+        detail::interned_type_names().intern(raw_type_name<T>());
+    return id;
+  }
+};
+} // namespace dingo
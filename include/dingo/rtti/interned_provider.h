@@ -0,0 +1,54 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/rtti/interned_table.h>
+#include <dingo/rtti/rtti.h>
+
+#include <cstdint>
+#include <typeindex>
+
+namespace dingo {
+namespace detail {
+// Types are keyed by std::type_index, which compares type names, so copies
+// of the same type_info emitted by several shared libraries share an id.
+using interned_type_table = interned_table<std::type_index>;
+
+// The table is never destroyed so that ids stay valid for static objects
+// destroyed at exit.
+//
+// Shared libraries see one table, and so one id per type, only when the
+// dynamic linker merges this inline function's static across them. On ELF the
+// default DINGO_RTTI_INTERNED_TABLE_API keeps the accessor visible under
+// -fvisibility=hidden and -fvisibility-inlines-hidden, but the merge does not
+// happen when DINGO_RTTI_INTERNED_TABLE_API is redefined without a visibility
+// attribute, for libraries loaded with RTLD_LOCAL, or for Windows DLLs unless
+// one of them exports the accessor and the others import it. In those setups
+// each module numbers types separately and ids must not cross modules.
+DINGO_RTTI_INTERNED_TABLE_API inline interned_type_table &
+interned_types() {
+  static auto *table = new interned_type_table();
+  return *table;
+}
+} // namespace detail
+
+template <> class rtti<interned_provider> {
+  template <typename T> struct wrapper {};
+
+public:
+  using type_index = detail::interned_type_index;
+
+  // The table is consulted once per type; later calls read a local static.
+  template <typename T> static type_index get_type_index() {
+    static const uint32_t id =
+        detail::interned_types().intern(std::type_index(typeid(wrapper<T>)));
+    return id;
+  }
+};
+} // namespace dingo
@@ -0,0 +1,71 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace dingo {
+namespace detail {
+// Process-wide table assigning dense ids to type keys in order of first use.
+template <typename Key> class interned_table {
+public:
+  template <typename Value> uint32_t intern(Value &&value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = ids_.try_emplace(
+        Key(std::forward<Value>(value)), static_cast<uint32_t>(ids_.size()));
+    (void)inserted;
+    return it->second;
+  }
+
+  std::size_t size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ids_.size();
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<Key, uint32_t> ids_;
+};
+
+// Dense type id handed out by an interned_table.
+class interned_type_index {
+  friend struct std::hash<interned_type_index>;
+
+public:
+  constexpr interned_type_index(uint32_t value) : value_(value) {}
+
+  constexpr bool operator<(const interned_type_index &other) const {
+    return value_ < other.value_;
+  }
+
+  constexpr bool operator==(const interned_type_index &other) const {
+    return value_ == other.value_;
+  }
+
+  constexpr uint32_t value() const { return value_; }
+
+private:
+  uint32_t value_;
+};
+} // namespace detail
+} // namespace dingo
+
+namespace std {
+template <> struct hash<dingo::detail::interned_type_index> {
+  size_t operator()(const dingo::detail::interned_type_index &value) const {
+    return value.value_;
+  }
+};
+} // namespace std
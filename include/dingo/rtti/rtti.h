@@ -12,6 +12,12 @@
 namespace dingo {
 struct static_provider {};
 struct typeid_provider {};
+// Dense 32-bit ids assigned on first use from a process-wide table; see
+// interned_provider.h for when modules share it.
+struct interned_provider {};
+// Dense 32-bit ids keyed by compile-time type names; needs no typeid and uses
+// the same kind of table.
+struct canonical_static_provider {};
 
 template <typename T> class rtti;
 } // namespace dingo
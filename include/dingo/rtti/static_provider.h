@@ -18,8 +18,8 @@ namespace dingo {
 
 template <> class rtti<static_provider> {
   template <typename T> struct type_index_tag {
-    // TODO: This will not work across modules.
-    // Should probably detect it first, handle it next.
+    // Each shared library has its own tag, so ids differ across modules.
+    // Use canonical_static_provider when types cross module boundaries.
     static constexpr size_t tag{};
   };
 
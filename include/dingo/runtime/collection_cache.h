@@ -0,0 +1,107 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/collection_view.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace dingo::detail {
+// Collections materialized by `view<T>()`, keyed by the type index of the
+// view. Registrations only advance the generation; the array built for an
+// older generation is freed when the collection is built again, so each
+// collection holds at most one array. Elements are pointers, so every array
+// is allocated as an array of `void *`.
+template <typename TypeIndex, typename Allocator> class collection_cache {
+  using array_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<void *>;
+  using array_traits = std::allocator_traits<array_allocator>;
+
+  struct entry {
+    std::size_t generation;
+    void **data;
+    std::size_t size;
+  };
+
+  using entry_allocator = typename std::allocator_traits<Allocator>::
+      template rebind_alloc<std::pair<const TypeIndex, entry>>;
+  using entry_map = std::unordered_map<TypeIndex, entry, std::hash<TypeIndex>,
+                                       std::equal_to<TypeIndex>,
+                                       entry_allocator>;
+
+public:
+  explicit collection_cache(Allocator &allocator)
+      : arrays_allocator_(allocator), entries_(entry_allocator(allocator)) {}
+
+  collection_cache(const collection_cache &) = delete;
+  collection_cache &operator=(const collection_cache &) = delete;
+
+  ~collection_cache() {
+    for (auto &cached : entries_) {
+      release(cached.second);
+    }
+  }
+
+  void invalidate() noexcept { ++generation_; }
+  std::size_t generation() const noexcept { return generation_; }
+
+  template <typename T>
+  bool find(TypeIndex type, std::size_t generation,
+            collection_view<T> &view) const {
+    auto it = entries_.find(type);
+    if (it == entries_.end() || it->second.generation != generation) {
+      return false;
+    }
+    view = collection_view<T>(reinterpret_cast<const T *>(it->second.data),
+                              it->second.size);
+    return true;
+  }
+
+  template <typename T, typename Collection>
+  collection_view<T> store(TypeIndex type, std::size_t generation,
+                           const Collection &values) {
+    static_assert(std::is_pointer_v<T> && sizeof(T) == sizeof(void *));
+    entry built{generation, nullptr, values.size()};
+    if (built.size != 0) {
+      built.data = array_traits::allocate(arrays_allocator_, built.size);
+      std::uninitialized_copy(values.begin(), values.end(),
+                              reinterpret_cast<T *>(built.data));
+    }
+
+    try {
+      auto [it, inserted] = entries_.try_emplace(type, built);
+      if (!inserted) {
+        release(it->second);
+        it->second = built;
+      }
+    } catch (...) {
+      release(built);
+      throw;
+    }
+    return collection_view<T>(reinterpret_cast<const T *>(built.data),
+                              built.size);
+  }
+
+private:
+  void release(entry &cached) noexcept {
+    if (cached.data != nullptr) {
+      array_traits::deallocate(arrays_allocator_, cached.data, cached.size);
+      cached.data = nullptr;
+    }
+  }
+
+  array_allocator arrays_allocator_;
+  entry_map entries_;
+  std::size_t generation_ = 0;
+};
+} // namespace dingo::detail
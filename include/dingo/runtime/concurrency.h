@@ -0,0 +1,268 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace dingo {
+// Registration and resolution must be serialized by the caller.
+struct single_threaded {};
+
+// Registration and resolution may run from multiple threads. Stable
+// resolutions are published into a lock-free snapshot that readers probe
+// without locking; everything else is serialized by a container mutex.
+struct concurrent {};
+
+namespace detail {
+template <typename T, typename = void> struct container_concurrency_type {
+  using type = single_threaded;
+};
+
+template <typename T>
+struct container_concurrency_type<T,
+                                  std::void_t<typename T::concurrency_type>> {
+  using type = typename T::concurrency_type;
+};
+
+template <typename T>
+using container_concurrency_type_t =
+    typename container_concurrency_type<T>::type;
+
+struct resolution_lock_none {};
+
+// Snapshot of the container whose parallel collection member the calling
+// thread constructs. The thread waiting for the members holds the container
+// lock, so a member that locks the container itself would deadlock.
+inline const void *&parallel_member_owner() noexcept {
+  static thread_local const void *owner = nullptr;
+  return owner;
+}
+
+class parallel_member_owner_scope {
+public:
+  explicit parallel_member_owner_scope(const void *owner) noexcept
+      : previous_(parallel_member_owner()) {
+    parallel_member_owner() = owner;
+  }
+
+  ~parallel_member_owner_scope() { parallel_member_owner() = previous_; }
+
+  parallel_member_owner_scope(const parallel_member_owner_scope &) = delete;
+  parallel_member_owner_scope &
+  operator=(const parallel_member_owner_scope &) = delete;
+
+private:
+  const void *previous_;
+};
+
+template <typename Concurrency, typename Allocator> class resolution_snapshot;
+
+template <typename Allocator>
+class resolution_snapshot<single_threaded, Allocator> {
+public:
+  static constexpr bool enabled = false;
+
+  explicit resolution_snapshot(const Allocator &) {}
+
+  resolution_lock_none lock() {
+    assert(parallel_member_owner() != this &&
+           "parallel collection members must not call into the container");
+    return {};
+  }
+
+  bool find(const void *, void *&) const { return false; }
+  void publish(const void *, void *) {}
+  void invalidate() {}
+};
+
+template <typename Allocator> class resolution_snapshot<concurrent, Allocator> {
+  struct slot {
+    std::atomic<const void *> key{nullptr};
+    std::atomic<void *> address{nullptr};
+  };
+
+  // Tables are append-only between invalidations. Growing a table publishes
+  // a replacement and retires the previous one until the container is
+  // destroyed, so readers never observe freed memory; capacities double, so
+  // the retired tables together are smaller than the current one.
+  // Invalidation clears the current table in place inside an odd generation,
+  // and readers drop a hit whose generation changed while they probed.
+  struct table {
+    table *retired = nullptr;
+    slot *slots = nullptr;
+    std::size_t mask = 0;
+    std::size_t size = 0;
+  };
+
+  using table_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<table>;
+  using slot_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+
+  static constexpr std::size_t initial_capacity = 16;
+
+public:
+  static constexpr bool enabled = true;
+
+  explicit resolution_snapshot(const Allocator &allocator)
+      : table_allocator_(allocator), slot_allocator_(allocator) {}
+
+  ~resolution_snapshot() {
+    destroy(table_.load(std::memory_order_relaxed));
+    destroy(retired_);
+  }
+
+  resolution_snapshot(const resolution_snapshot &) = delete;
+  resolution_snapshot &operator=(const resolution_snapshot &) = delete;
+
+  std::unique_lock<std::recursive_mutex> lock() {
+    assert(parallel_member_owner() != this &&
+           "parallel collection members must not call into the container");
+    return std::unique_lock<std::recursive_mutex>(mutex_);
+  }
+
+  DINGO_ALWAYS_INLINE bool find(const void *key, void *&address) const {
+    const std::size_t generation = generation_.load(std::memory_order_acquire);
+    if (generation & 1) {
+      return false;
+    }
+    auto *current = table_.load(std::memory_order_acquire);
+    if (current == nullptr) {
+      return false;
+    }
+    for (std::size_t index = hash(key) & current->mask;;
+         index = (index + 1) & current->mask) {
+      auto &entry = current->slots[index];
+      const void *entry_key = entry.key.load(std::memory_order_acquire);
+      if (entry_key == key) {
+        address = entry.address.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return generation_.load(std::memory_order_relaxed) == generation;
+      }
+      if (entry_key == nullptr) {
+        return false;
+      }
+    }
+  }
+
+  // Requires lock().
+  void publish(const void *key, void *address) {
+    void *existing = nullptr;
+    if (find(key, existing)) {
+      return;
+    }
+
+    auto *current = table_.load(std::memory_order_relaxed);
+    if (current == nullptr || (current->size + 1) * 2 > current->mask + 1) {
+      current = grow(current);
+    }
+    insert(*current, key, address);
+  }
+
+  // Requires lock().
+  void invalidate() {
+    auto *current = table_.load(std::memory_order_relaxed);
+    if (current == nullptr || current->size == 0) {
+      return;
+    }
+    const std::size_t generation = generation_.load(std::memory_order_relaxed);
+    generation_.store(generation + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i <= current->mask; ++i) {
+      current->slots[i].key.store(nullptr, std::memory_order_relaxed);
+      current->slots[i].address.store(nullptr, std::memory_order_relaxed);
+    }
+    current->size = 0;
+    generation_.store(generation + 2, std::memory_order_release);
+  }
+
+private:
+  static std::size_t hash(const void *key) {
+    auto value =
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+    return static_cast<std::size_t>((value * 0x9E3779B97F4A7C15ull) >> 32);
+  }
+
+  static void insert(table &target, const void *key, void *address) {
+    for (std::size_t index = hash(key) & target.mask;;
+         index = (index + 1) & target.mask) {
+      auto &entry = target.slots[index];
+      if (entry.key.load(std::memory_order_relaxed) == nullptr) {
+        entry.address.store(address, std::memory_order_relaxed);
+        entry.key.store(key, std::memory_order_release);
+        ++target.size;
+        return;
+      }
+    }
+  }
+
+  table *grow(table *current) {
+    const std::size_t capacity =
+        current != nullptr ? (current->mask + 1) * 2 : initial_capacity;
+    auto *next = std::allocator_traits<table_allocator_type>::allocate(
+        table_allocator_, 1);
+    new (next) table();
+    next->slots = std::allocator_traits<slot_allocator_type>::allocate(
+        slot_allocator_, capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+      new (&next->slots[i]) slot();
+    }
+    next->mask = capacity - 1;
+
+    if (current != nullptr) {
+      for (std::size_t i = 0; i <= current->mask; ++i) {
+        auto &entry = current->slots[i];
+        if (const void *key = entry.key.load(std::memory_order_relaxed)) {
+          insert(*next, key, entry.address.load(std::memory_order_relaxed));
+        }
+      }
+    }
+
+    table_.store(next, std::memory_order_release);
+    if (current != nullptr) {
+      retire(current);
+    }
+    return next;
+  }
+
+  void retire(table *value) {
+    value->retired = retired_;
+    retired_ = value;
+  }
+
+  void destroy(table *value) {
+    while (value != nullptr) {
+      auto *retired = value->retired;
+      std::allocator_traits<slot_allocator_type>::deallocate(
+          slot_allocator_, value->slots, value->mask + 1);
+      value->~table();
+      std::allocator_traits<table_allocator_type>::deallocate(table_allocator_,
+                                                              value, 1);
+      value = retired;
+    }
+  }
+
+  std::atomic<table *> table_{nullptr};
+  // Odd while invalidate() clears the table.
+  std::atomic<std::size_t> generation_{0};
+  table *retired_ = nullptr;
+  std::recursive_mutex mutex_;
+  table_allocator_type table_allocator_;
+  slot_allocator_type slot_allocator_;
+};
+} // namespace detail
+} // namespace dingo
@@ -14,9 +14,27 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 namespace dingo {
+namespace detail {
+template <typename T, typename = void> struct container_arena_growth_type {
+  using type = arena_growth<DINGO_RUNTIME_ARENA_BLOCK_SIZE,
+                            DINGO_RUNTIME_ARENA_MAX_BLOCK_SIZE>;
+};
+
+template <typename T>
+struct container_arena_growth_type<
+    T, std::void_t<typename T::arena_growth_type>> {
+  using type = typename T::arena_growth_type;
+};
+
+template <typename T>
+using container_arena_growth_type_t =
+    typename container_arena_growth_type<T>::type;
+} // namespace detail
+
 
 template <typename Allocator> class runtime_transaction;
 
@@ -35,7 +53,13 @@ public:
   };
 
   explicit container_runtime(const Allocator &allocator)
-      : arena_(DINGO_RUNTIME_ARENA_BLOCK_SIZE, allocator) {}
+      : container_runtime(allocator,
+                          detail::container_arena_growth_type_t<void>()) {}
+
+  template <std::size_t BlockSize, std::size_t MaxBlockSize>
+  container_runtime(const Allocator &allocator,
+                    arena_growth<BlockSize, MaxBlockSize> growth)
+      : arena_(growth, allocator) {}
 
   ~container_runtime() {
     assert(active_transaction_ == nullptr);
@@ -66,6 +90,19 @@ public:
 
   void commit(checkpoint) {}
 
+  // Makes room for `size` bytes of instances without further allocations.
+  void reserve(std::size_t size) {
+    assert(active_transaction_ == nullptr);
+    static_cast<void>(arena_.reserve(size));
+  }
+
+  std::size_t arena_reserved() const { return arena_.reserved(); }
+  std::size_t arena_used() const { return arena_.used(); }
+  // Walks the destructor journal, O(n) in the number of entries.
+  std::size_t destructor_count() const { return store_.destructor_count(); }
+
+  bool in_transaction() const { return active_transaction_ != nullptr; }
+
 private:
   arena_type arena_;
   store_type store_;
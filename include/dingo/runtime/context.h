@@ -9,6 +9,8 @@
 
 #include <dingo/core/context_base.h>
 #include <dingo/memory/object_store.h>
+#include <dingo/runtime/parallel_collection.h>
+#include <dingo/runtime/session.h>
 #include <dingo/runtime/transaction.h>
 
 #include <memory>
@@ -45,6 +47,13 @@ public:
       : scratch_(std::addressof(scratch)),
         transaction_(std::addressof(transaction)) {}
 
+  // Context of a collection member constructed on an executor thread. It
+  // joins the transaction of `owner` and synchronizes through `member`.
+  runtime_context(arena<> &scratch, runtime_context &owner,
+                  detail::parallel_member &member)
+      : scratch_(std::addressof(scratch)), transaction_(owner.transaction_),
+        parallel_(std::addressof(member)) {}
+
   ~runtime_context() noexcept { ephemeral_store_.destroy(*scratch_); }
 
   runtime_context(const runtime_context &) = delete;
@@ -102,8 +111,26 @@ public:
     transaction_->add_runtime_destructor(instance, dtor);
   }
 
+  // Runs the constructor of a unique instance.
+  template <typename Fn> decltype(auto) invoke_constructor(Fn &&fn) {
+    if (parallel_ != nullptr) {
+      return parallel_->construct(std::forward<Fn>(fn));
+    }
+    return std::forward<Fn>(fn)();
+  }
+
   template <typename T, typename Container>
   T resolve(construction_scope scope, Container &container) {
+    if (parallel_ != nullptr) {
+      return parallel_->resolve(
+          [&]() -> T { return resolve_dependency<T>(scope, container); });
+    }
+    return resolve_dependency<T>(scope, container);
+  }
+
+private:
+  template <typename T, typename Container>
+  T resolve_dependency(construction_scope scope, Container &container) {
     if constexpr (detail::is_selected_v<T>) {
       using request_type = detail::selected_type_t<T>;
       using selector_type = detail::selected_selector_t<T>;
@@ -124,7 +151,6 @@ public:
     }
   }
 
-private:
   template <typename T, typename ConstructFn>
   T &construct_with_scope(construction_scope scope,
                           ConstructFn &&construct_fn) {
@@ -140,6 +166,7 @@ private:
   arena<> *scratch_;
   detail::object_store<arena<>> ephemeral_store_;
   transaction_type *transaction_;
+  detail::parallel_member *parallel_ = nullptr;
 };
 
 namespace detail {
@@ -166,13 +193,11 @@ private:
   Transaction *transaction_;
 };
 
-} // namespace detail
-
 template <typename Runtime, typename Fn>
-DINGO_NOINLINE decltype(auto) execute_transaction(Runtime &runtime, Fn &&fn) {
+decltype(auto) execute_root_transaction(Runtime &runtime, arena<> &scratch,
+                                        Fn &&fn) {
   using allocator_type = typename Runtime::allocator_type;
   using context_type = runtime_context<allocator_type>;
-  inline_arena<DINGO_CONTEXT_ARENA_BUFFER_SIZE> scratch;
   runtime_transaction<allocator_type> transaction(runtime, scratch);
   context_type context(scratch, transaction);
   detail::transaction_commit_guard commit(transaction);
@@ -189,6 +214,20 @@ DINGO_NOINLINE decltype(auto) execute_transaction(Runtime &runtime, Fn &&fn) {
   }
 }
 
+} // namespace detail
+
+template <typename Runtime, typename Fn>
+DINGO_NOINLINE decltype(auto) execute_transaction(Runtime &runtime, Fn &&fn) {
+  if (auto session = resolution_session::current()) {
+    resolution_session::scope scope(*session);
+    return detail::execute_root_transaction(runtime, scope.scratch(),
+                                            std::forward<Fn>(fn));
+  }
+  inline_arena<DINGO_CONTEXT_ARENA_BUFFER_SIZE> scratch;
+  return detail::execute_root_transaction(runtime, scratch,
+                                          std::forward<Fn>(fn));
+}
+
 template <typename Runtime, typename Allocator, typename Fn>
 auto execute_transaction(Runtime &runtime, runtime_context<Allocator> &context,
                          Fn &&fn)
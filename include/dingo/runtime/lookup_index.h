@@ -9,9 +9,11 @@
 
 #include <dingo/core/none.h>
 #include <dingo/lookup/lookup.h>
+#include <dingo/lookup/operations.h>
 #include <dingo/lookup/storage.h>
 #include <dingo/type/type_list.h>
 
+#include <cstddef>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -94,6 +96,12 @@ public:
     }
   }
 
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    if (value_) {
+      fn(*value_);
+    }
+  }
+
 private:
   std::optional<Value> value_;
 };
@@ -139,6 +147,12 @@ public:
 
   void erase(iterator handle) { values_.erase(handle); }
 
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    for (auto &value : values_) {
+      fn(value);
+    }
+  }
+
 private:
   storage_type values_;
 };
@@ -206,6 +220,143 @@ public:
   const lookup_backend<Entry, Value, Allocator> &get() const {
     return lookup_index_member<Entry, Value, Allocator>::backend;
   }
+
+  // Visits every value of every backend. A value registered under several
+  // lookups is visited once per lookup.
+  template <typename Fn> void for_each_value(Fn &&fn) {
+    (lookup_for_each_value(get<Entries>(), fn), ...);
+  }
+
+  // Calls `fn` with the number of values of every backend, in declaration
+  // order.
+  template <typename Fn> void for_each_value_count(Fn &&fn) {
+    (fn(value_count(get<Entries>())), ...);
+  }
+
+private:
+  template <typename Backend> static std::size_t value_count(Backend &backend) {
+    std::size_t count = 0;
+    auto counter = [&](auto &) { ++count; };
+    lookup_for_each_value(backend, counter);
+    return count;
+  }
+};
+
+// Contiguous storage a lookup is compiled into when its container is frozen.
+// Node-based backends are replaced; the others are already flat and keep
+// serving lookups.
+template <typename BackendKey, typename Backend, typename Value,
+          typename Cardinality, typename Allocator>
+struct frozen_lookup_storage_type {
+  using type = void;
+};
+
+// Rows of an ordered backend are appended unchecked and sorted once, as the
+// backend already rejected duplicate keys of `one` lookups.
+template <typename BackendKey, typename Value, typename Cardinality,
+          typename Allocator>
+struct frozen_lookup_storage_type<BackendKey, ::dingo::ordered, Value,
+                                  Cardinality, Allocator> {
+  using type =
+      sorted_lookup_storage<BackendKey, Value, ::dingo::many, Allocator>;
+};
+
+// A sorted backend may keep a short unsorted tail after commit(); its frozen
+// copy is merged in full.
+template <typename BackendKey, typename Value, typename Cardinality,
+          typename Allocator>
+struct frozen_lookup_storage_type<BackendKey, ::dingo::sorted, Value,
+                                  Cardinality, Allocator> {
+  using type =
+      sorted_lookup_storage<BackendKey, Value, ::dingo::many, Allocator>;
+};
+
+template <typename BackendKey, typename Value, typename Cardinality,
+          typename Allocator>
+struct frozen_lookup_storage_type<BackendKey, ::dingo::unordered, Value,
+                                  Cardinality, Allocator> {
+  using type =
+      flat_unordered_lookup_storage<BackendKey, Value, Cardinality, Allocator>;
+};
+
+template <typename Entry, typename Value, typename Allocator>
+struct frozen_lookup_storage;
+
+template <typename Interface, typename KeyDefinition, typename Cardinality,
+          typename Backend, typename Value, typename Allocator>
+struct frozen_lookup_storage<
+    lookup_entry<Interface, KeyDefinition, Cardinality, Backend>, Value,
+    Allocator> {
+  using type = typename frozen_lookup_storage_type<
+      typename KeyDefinition::backend_key_type, Backend, Value, Cardinality,
+      Allocator>::type;
+};
+
+template <typename Entry, typename Value, typename Allocator>
+using frozen_lookup_storage_t =
+    typename frozen_lookup_storage<Entry, Value, Allocator>::type;
+
+template <typename Storage, typename Key, typename Inserted, typename = void>
+struct has_lookup_storage_emplace : std::false_type {};
+
+template <typename Storage, typename Key, typename Inserted>
+struct has_lookup_storage_emplace<
+    Storage, Key, Inserted,
+    std::void_t<decltype(std::declval<Storage &>().emplace(
+        std::declval<const Key &>(), std::declval<Inserted>()))>>
+    : std::true_type {};
+
+template <typename Entry, typename Value, typename Allocator,
+          typename Storage = frozen_lookup_storage_t<Entry, Value, Allocator>>
+struct frozen_lookup_member {
+  frozen_lookup_member(lookup_backend<Entry, Value, Allocator> &source,
+                       Allocator &allocator)
+      : storage(make_lookup_storage<Storage>(allocator)) {
+    for (auto &row : source) {
+      if constexpr (has_lookup_storage_emplace<Storage, decltype(row.first),
+                                               Value>::value) {
+        storage.emplace(row.first, Value(row.second.view()));
+      } else {
+        storage.try_emplace(row.first, Value(row.second.view()));
+      }
+    }
+    if constexpr (has_lookup_storage_commit_v<Storage>) {
+      storage.commit();
+    }
+  }
+
+  Storage storage;
+};
+
+template <typename Entry, typename Value, typename Allocator>
+struct frozen_lookup_member<Entry, Value, Allocator, void> {
+  frozen_lookup_member(lookup_backend<Entry, Value, Allocator> &, Allocator &) {
+  }
+};
+
+// Read-only copy of the node-based backends of a lookup index, built once
+// registrations are over.
+template <typename EntryList, typename Value, typename Allocator>
+class frozen_lookup_index;
+
+template <typename... Entries, typename Value, typename Allocator>
+class frozen_lookup_index<::dingo::type_list<Entries...>, Value, Allocator>
+    : frozen_lookup_member<Entries, Value, Allocator>... {
+public:
+  template <typename Entry>
+  static constexpr bool contains_v =
+      !std::is_void_v<frozen_lookup_storage_t<Entry, Value, Allocator>>;
+
+  frozen_lookup_index(
+      lookup_index<::dingo::type_list<Entries...>, Value, Allocator> &source,
+      Allocator &allocator)
+      : frozen_lookup_member<Entries, Value, Allocator>(
+            source.template get<Entries>(), allocator)... {}
+
+  template <typename Entry>
+  frozen_lookup_storage_t<Entry, Value, Allocator> &get() {
+    return frozen_lookup_member<Entry, Value, Allocator>::storage;
+  }
 };
 
 } // namespace dingo::detail
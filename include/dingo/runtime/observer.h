@@ -0,0 +1,117 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/type/type_descriptor.h>
+
+#include <chrono>
+#include <exception>
+#include <type_traits>
+
+namespace dingo {
+// Base for resolution observers declared as `observer_type` in container
+// traits. Hooks are static and an observer overrides the ones it needs:
+//
+// - `on_resolve_begin(type)` and `on_resolve_end(type, duration)` bracket a
+//   public `resolve<T>()` call; `type` describes `T`,
+// - `on_cache_hit(type)` reports that the request was served by a cached
+//   address without entering a transaction,
+// - `on_construct(type, duration)` reports a runtime binding that
+//   constructed its instance; `type` is the registered type and `duration`
+//   includes dependencies constructed on its behalf.
+struct resolution_observer {
+  static void on_resolve_begin(type_descriptor) {}
+  static void on_resolve_end(type_descriptor, std::chrono::nanoseconds) {}
+  static void on_cache_hit(type_descriptor) {}
+  static void on_construct(type_descriptor, std::chrono::nanoseconds) {}
+};
+
+namespace detail {
+template <typename T, typename = void> struct container_observer_type {
+  using type = void;
+};
+
+template <typename T>
+struct container_observer_type<T, std::void_t<typename T::observer_type>> {
+  using type = typename T::observer_type;
+};
+
+template <typename T>
+using container_observer_type_t = typename container_observer_type<T>::type;
+
+template <typename Observer> class resolve_observation {
+public:
+  explicit resolve_observation(type_descriptor type)
+      : type_(type), start_(std::chrono::steady_clock::now()) {
+    Observer::on_resolve_begin(type_);
+  }
+
+  resolve_observation(const resolve_observation &) = delete;
+  resolve_observation &operator=(const resolve_observation &) = delete;
+
+  ~resolve_observation() {
+    Observer::on_resolve_end(type_, std::chrono::steady_clock::now() - start_);
+  }
+
+private:
+  type_descriptor type_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <> class resolve_observation<void> {
+public:
+  explicit resolve_observation(type_descriptor) {}
+};
+
+// Reports a construction when the guarded scope completes without throwing.
+// `constructs` is only evaluated when an observer is configured.
+template <typename Observer> class construct_observation {
+public:
+  template <typename Constructs>
+  construct_observation(type_descriptor type, Constructs &&constructs)
+      : type_(type), active_(constructs()),
+        exceptions_(std::uncaught_exceptions()) {
+    if (active_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  construct_observation(const construct_observation &) = delete;
+  construct_observation &operator=(const construct_observation &) = delete;
+
+  ~construct_observation() {
+    if (active_ && std::uncaught_exceptions() == exceptions_) {
+      Observer::on_construct(type_,
+                             std::chrono::steady_clock::now() - start_);
+    }
+  }
+
+private:
+  type_descriptor type_;
+  bool active_;
+  int exceptions_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <> class construct_observation<void> {
+public:
+  template <typename Constructs>
+  construct_observation(type_descriptor, Constructs &&) {}
+};
+
+template <typename Observer>
+DINGO_ALWAYS_INLINE void observe_cache_hit(type_descriptor type) {
+  if constexpr (!std::is_void_v<Observer>) {
+    Observer::on_cache_hit(type);
+  } else {
+    (void)type;
+  }
+}
+} // namespace detail
+} // namespace dingo
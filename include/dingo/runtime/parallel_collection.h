@@ -0,0 +1,184 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/registration/collection_traits.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace dingo::detail {
+// Container state of a parallel collection construction is guarded by a
+// baton mutex that each member holds while it runs. The member hands it back
+// while its own unique storage runs the constructor and takes it again for
+// every dependency the constructor resolves, so only constructor bodies of
+// different members overlap.
+class parallel_member {
+  struct relock {
+    ~relock() {
+      member.baton_->lock();
+      member.released_ = false;
+    }
+    parallel_member &member;
+  };
+
+  struct unlock {
+    ~unlock() {
+      member.released_ = true;
+      member.baton_->unlock();
+    }
+    parallel_member &member;
+  };
+
+public:
+  explicit parallel_member(std::mutex &baton) : baton_(&baton) {}
+
+  parallel_member(const parallel_member &) = delete;
+  parallel_member &operator=(const parallel_member &) = delete;
+
+  // Set right before the member binding resolves; the first unique storage
+  // reached afterwards constructs the member itself.
+  void arm() noexcept { armed_ = true; }
+
+  template <typename Fn> decltype(auto) construct(Fn &&fn) {
+    if (!armed_) {
+      return std::forward<Fn>(fn)();
+    }
+    armed_ = false;
+    released_ = true;
+    baton_->unlock();
+    relock guard{*this};
+    return std::forward<Fn>(fn)();
+  }
+
+  template <typename Fn> decltype(auto) resolve(Fn &&fn) {
+    armed_ = false;
+    if (!released_) {
+      return std::forward<Fn>(fn)();
+    }
+    baton_->lock();
+    released_ = false;
+    unlock guard{*this};
+    return std::forward<Fn>(fn)();
+  }
+
+private:
+  std::mutex *baton_;
+  bool armed_ = false;
+  bool released_ = false;
+};
+
+// Constructs the members of one collection on an executor. Results are kept
+// by member index, so the collection is filled in registration order no
+// matter which task finishes first.
+template <typename T> class parallel_collection {
+public:
+  using construct_function = T (*)(void *container, void *context,
+                                    void *binding, parallel_member &member);
+
+  class task {
+  public:
+    void operator()() const noexcept { owner_->run(index_); }
+
+  private:
+    friend class parallel_collection;
+
+    task(parallel_collection *owner, std::size_t index)
+        : owner_(owner), index_(index) {}
+
+    parallel_collection *owner_;
+    std::size_t index_;
+  };
+
+  parallel_collection(void *container, void *context,
+                      construct_function construct,
+                      const std::vector<void *> &bindings)
+      : container_(container), context_(context), construct_(construct),
+        bindings_(bindings), results_(bindings.size()),
+        pending_(bindings.size()) {}
+
+  parallel_collection(const parallel_collection &) = delete;
+  parallel_collection &operator=(const parallel_collection &) = delete;
+
+  // Hands every member to `executor` and waits for all of them, including
+  // when the executor fails to accept a task.
+  template <typename Executor> void execute(Executor &executor) {
+    std::size_t dispatched = 0;
+    try {
+      for (; dispatched < bindings_.size(); ++dispatched) {
+        executor(task(this, dispatched));
+      }
+    } catch (...) {
+      finish(bindings_.size() - dispatched);
+      wait();
+      throw;
+    }
+    wait();
+  }
+
+  // Rethrows the failure of the first failed member, otherwise moves the
+  // members into `results`.
+  template <typename Collection> void collect(Collection &results) {
+    if (failure_) {
+      std::rethrow_exception(failure_);
+    }
+    collection_traits<Collection>::reserve(results, results_.size());
+    for (auto &value : results_) {
+      collection_traits<Collection>::add(results, std::move(*value));
+    }
+  }
+
+private:
+  void run(std::size_t index) noexcept {
+    try {
+      std::unique_lock<std::mutex> baton(baton_);
+      parallel_member member(baton_);
+      results_[index].emplace(
+          construct_(container_, context_, bindings_[index], member));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!failure_ || index < failure_index_) {
+        failure_ = std::current_exception();
+        failure_index_ = index;
+      }
+    }
+    finish(1);
+  }
+
+  void finish(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ -= count;
+    if (pending_ == 0) {
+      finished_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+  void *container_;
+  void *context_;
+  construct_function construct_;
+  const std::vector<void *> &bindings_;
+  std::vector<std::optional<T>> results_;
+
+  std::mutex baton_;
+  std::mutex mutex_;
+  std::condition_variable finished_;
+  std::size_t pending_;
+  std::exception_ptr failure_;
+  std::size_t failure_index_ = 0;
+};
+} // namespace dingo::detail
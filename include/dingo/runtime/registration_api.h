@@ -11,6 +11,7 @@
 #include <dingo/core/none.h>
 #include <dingo/factory/callable.h>
 #include <dingo/registration/type_registration.h>
+#include <dingo/runtime/concurrency.h>
 
 #include <type_traits>
 #include <utility>
@@ -26,7 +27,11 @@ public:
     return self().binding_store().get_allocator();
   }
 
+  // Derived containers shadow this to synchronize registrations.
+  resolution_lock_none registration_scope() { return {}; }
+
   template <typename... TypeArgs> auto register_type() {
+    [[maybe_unused]] auto scope = self().registration_scope();
     return self().binding_store().template prepare_binding<TypeArgs...>(
         &self().runtime_registration_parent(), none_t{});
   }
@@ -35,6 +40,7 @@ public:
             std::enable_if_t<!detail::is_runtime_registration_key_arg_v<Arg>,
                              int> = 0>
   auto register_type(Arg &&arg) {
+    [[maybe_unused]] auto scope = self().registration_scope();
     return self().binding_store().template prepare_binding<TypeArgs...>(
         &self().runtime_registration_parent(), std::forward<Arg>(arg));
   }
@@ -45,6 +51,7 @@ public:
                  detail::are_runtime_registration_key_args_v<KeyArgs...>),
                 int> = 0>
   auto register_type(KeyArgs &&...keys) {
+    [[maybe_unused]] auto scope = self().registration_scope();
     return self().binding_store().template prepare_binding<TypeArgs...>(
         &self().runtime_registration_parent(), none_t{},
         std::forward<KeyArgs>(keys)...);
@@ -57,6 +64,7 @@ public:
                  detail::are_runtime_registration_key_args_v<KeyArgs...>),
                 int> = 0>
   auto register_type(Arg &&arg, KeyArgs &&...keys) {
+    [[maybe_unused]] auto scope = self().registration_scope();
     return self().binding_store().template prepare_binding<TypeArgs...>(
         &self().runtime_registration_parent(), std::forward<Arg>(arg),
         std::forward<KeyArgs>(keys)...);
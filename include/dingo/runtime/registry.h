@@ -15,6 +15,7 @@
 #include <dingo/core/exceptions.h>
 #include <dingo/core/key.h>
 #include <dingo/core/none.h>
+#include <dingo/core/warm_up.h>
 #include <dingo/factory/callable.h>
 #include <dingo/factory/invoke.h>
 #include <dingo/lookup/lookup.h>
@@ -25,9 +26,11 @@
 #include <dingo/registration/requirements.h>
 #include <dingo/resolution/runtime_binding.h>
 #include <dingo/runtime/container_runtime.h>
+#include <dingo/runtime/concurrency.h>
 #include <dingo/runtime/container_traits.h>
 #include <dingo/runtime/context.h>
 #include <dingo/runtime/lookup_index.h>
+#include <dingo/runtime/statistics.h>
 #include <dingo/runtime/transaction.h>
 #include <dingo/storage/interface_storage_traits.h>
 #include <dingo/type/dependency_traits.h>
@@ -36,6 +39,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <limits>
@@ -89,6 +93,7 @@ public:
   runtime_lookup_value &operator=(const runtime_lookup_value &) = delete;
 
   BindingInterface &binding() { return *view_.binding; }
+  binding_view_type view() const { return view_; }
 
 private:
   binding_view_type view_;
@@ -97,11 +102,15 @@ private:
 template <typename LookupEntries, typename BindingInterface, typename Allocator>
 struct runtime_bindings_state {
   using value_type = runtime_lookup_value<BindingInterface>;
+  using frozen_index_type =
+      frozen_lookup_index<LookupEntries, value_type, Allocator>;
 
   explicit runtime_bindings_state(Allocator &allocator)
       : lookup_indexes(allocator) {}
 
   lookup_index<LookupEntries, value_type, Allocator> lookup_indexes;
+  // Set by freeze(); lookups it holds are served from it from then on.
+  frozen_index_type *frozen = nullptr;
 };
 
 template <typename BindingsState> struct runtime_scope_state {
@@ -119,8 +128,9 @@ struct runtime_registry_data {
   using scope_pointer_allocator = typename std::allocator_traits<
       Allocator>::template rebind_alloc<scope_state_type *>;
 
-  explicit runtime_registry_data(Allocator &allocator)
-      : runtime(allocator), bindings(allocator),
+  template <typename ArenaGrowth>
+  runtime_registry_data(Allocator &allocator, ArenaGrowth growth)
+      : runtime(allocator, growth), bindings(allocator),
         scope_states(scope_pointer_allocator(allocator)) {}
 
   std::size_t create_scope(scope_state_type *state) {
@@ -152,8 +162,9 @@ template <typename Data, bool OwnsData> class runtime_data_holder;
 
 template <typename Data> class runtime_data_holder<Data, true> {
 public:
-  template <typename Allocator>
-  explicit runtime_data_holder(Allocator &allocator) : data_(allocator) {}
+  template <typename Allocator, typename ArenaGrowth>
+  runtime_data_holder(Allocator &allocator, ArenaGrowth growth)
+      : data_(allocator, growth) {}
 
   Data &get() noexcept { return data_; }
 
@@ -345,9 +356,12 @@ protected:
       detail::runtime_lookup_value<runtime_binding_interface_type>;
   using runtime_bindings_state = detail::runtime_bindings_state<
       lookup_index_entries, runtime_binding_interface_type, allocator_type>;
+  using frozen_index_type = typename runtime_bindings_state::frozen_index_type;
   using runtime_data_type =
       detail::runtime_registry_data<allocator_type, runtime_bindings_state>;
   using runtime_scope_state = typename runtime_data_type::scope_state_type;
+  using arena_growth_type =
+      detail::container_arena_growth_type_t<ContainerTraits>;
 
 private:
   static runtime_data_type &borrow_runtime_data(resolve_root_type *root) {
@@ -363,13 +377,14 @@ private:
 public:
   runtime_registry()
       : allocator_base<allocator_type>(allocator_type()),
-        runtime_data_(get_allocator()) {
+        runtime_data_(get_allocator(), arena_growth_type()) {
     static_assert(OwnsRuntimeData);
     validate_lookup_definitions();
   }
 
   runtime_registry(const allocator_type &alloc)
-      : allocator_base<allocator_type>(alloc), runtime_data_(get_allocator()) {
+      : allocator_base<allocator_type>(alloc),
+        runtime_data_(get_allocator(), arena_growth_type()) {
     static_assert(OwnsRuntimeData);
     validate_lookup_definitions();
   }
@@ -377,7 +392,7 @@ public:
   runtime_registry(detail::runtime_data_owner_t, parent_container_type *parent,
                    const allocator_type &alloc = allocator_type())
       : allocator_base<allocator_type>(alloc), parent_(parent),
-        runtime_data_(get_allocator()) {
+        runtime_data_(get_allocator(), arena_growth_type()) {
     static_assert(OwnsRuntimeData);
     validate_lookup_definitions();
   }
@@ -492,6 +507,14 @@ protected:
 
   parent_container_type *parent() { return parent_; }
 
+  auto registration_root_scope() {
+    if constexpr (OwnsRuntimeData) {
+      return detail::resolution_lock_none{};
+    } else {
+      return resolve_root()->registration_scope();
+    }
+  }
+
   resolve_root_type *resolve_root() {
     if constexpr (std::is_same_v<void, ResolveRoot> ||
                   std::is_same_v<resolve_root_type, registry_type>) {
@@ -650,6 +673,143 @@ protected:
     return detail::convert_resolved_binding<Request>(result.address);
   }
 
+  // Only bindings that cache their address keep it stable for the lifetime
+  // of the container.
+  template <typename Request>
+  static void check_stable_binding(runtime_selection selection) {
+    if (selection.status == detail::binding_status::not_found) {
+      throw detail::make_type_not_found_exception<Request>();
+    }
+    if (selection.status == detail::binding_status::ambiguous) {
+      throw detail::make_type_ambiguous_exception<Request>();
+    }
+    if (selection.binding->cache_slot() == nullptr) {
+      throw detail::make_unstable_binding_exception<Request>();
+    }
+  }
+
+  // Throws unless every binding of the collection keeps a stable address.
+  template <typename T, typename LookupKey,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  void check_stable_collection(LookupKey key) {
+    using resolve_type = typename collection_traits<T>::resolve_type;
+    if (auto *state = runtime_bindings()) {
+      for_each_collection_entry<T>(*state, key, [](auto &entry) {
+        if (entry.binding().cache_slot() == nullptr) {
+          throw detail::make_unstable_binding_exception<resolve_type>();
+        }
+      });
+    }
+  }
+
+  using binding_pointer_allocator = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<runtime_binding_interface_type *>;
+  using binding_position_allocator = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<std::size_t>;
+
+  // Bindings of `state` in the order lookups first reach them, each once even
+  // when it serves several lookups. Positions are sorted by binding to find
+  // the repeats, so the order does not depend on binding addresses.
+  std::vector<runtime_binding_interface_type *, binding_pointer_allocator>
+  registered_bindings(runtime_bindings_state &state) {
+    std::vector<runtime_binding_interface_type *, binding_pointer_allocator>
+        bindings{binding_pointer_allocator(get_allocator())};
+    state.lookup_indexes.for_each_value([&](runtime_lookup_value &value) {
+      bindings.push_back(std::addressof(value.binding()));
+    });
+    std::vector<std::size_t, binding_position_allocator> positions(
+        bindings.size(), binding_position_allocator(get_allocator()));
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+      positions[i] = i;
+    }
+    std::stable_sort(positions.begin(), positions.end(),
+                     [&](std::size_t lhs, std::size_t rhs) {
+                       return std::less<runtime_binding_interface_type *>()(
+                           bindings[lhs], bindings[rhs]);
+                     });
+    runtime_binding_interface_type *previous = nullptr;
+    for (auto position : positions) {
+      if (bindings[position] == previous) {
+        bindings[position] = nullptr;
+      } else {
+        previous = bindings[position];
+      }
+    }
+    bindings.erase(std::remove(bindings.begin(), bindings.end(), nullptr),
+                   bindings.end());
+    return bindings;
+  }
+
+  // Materializes the shared bindings accepted by `filter`, visiting and
+  // reporting them in the order lookups first reach them. Each binding
+  // resolves its dependencies first, so the graph is built bottom-up and a
+  // dependency visited later reports only the time to find its instance.
+  void warm_up(runtime_context_type &context, detail::warm_up_filter filter,
+               warm_up_report &report) {
+    auto *state = runtime_bindings();
+    if (!state) {
+      return;
+    }
+
+    for (auto *binding : registered_bindings(*state)) {
+      detail::warm_up_result result;
+      warm_up_update update{
+          {binding->cache_slot(), std::addressof(context), nullptr}, &result};
+      const warm_up_request<rtti_type> request{
+          {rtti_type::template get_type_index<detail::warm_up_tag>(),
+           describe_type<detail::warm_up_tag>()},
+          filter,
+          &result};
+      const auto start = std::chrono::steady_clock::now();
+      binding->resolve_request(ephemeral_scope, context, request,
+                               update.sink());
+      const auto finish = std::chrono::steady_clock::now();
+      if (result.warmed) {
+        report.push_back(
+            {result.interface_type,
+             std::chrono::duration_cast<std::chrono::nanoseconds>(finish -
+                                                                  start)});
+      }
+    }
+  }
+
+  // Reserves arena space for about `count` more runtime bindings.
+  void reserve_bindings(std::size_t count) {
+    runtime().reserve(count * DINGO_RUNTIME_BINDING_RESERVE_SIZE);
+  }
+
+  // Copies the node-based lookups into contiguous tables that serve every
+  // later lookup. The caller rejects registrations from then on, so the
+  // tables are never updated or rolled back. Only the root is frozen; the
+  // containers of its registrations are frozen with it.
+  void freeze() {
+    static_assert(OwnsRuntimeData,
+                  "only the registry owning the runtime data can be frozen");
+    auto &state = *runtime_bindings();
+    if (state.frozen == nullptr) {
+      state.frozen = std::addressof(
+          runtime().template construct<frozen_index_type>(
+              state.lookup_indexes, get_allocator()));
+    }
+  }
+
+  // Registration containers share the root's runtime data and so its state.
+  bool frozen() { return shared_runtime_data().bindings.frozen != nullptr; }
+
+  // Fills the binding and memory part of `statistics`.
+  void statistics(container_statistics &statistics) {
+    auto &runtime_state = runtime();
+    statistics.arena_reserved = runtime_state.arena_reserved();
+    statistics.arena_used = runtime_state.arena_used();
+    statistics.destructors = runtime_state.destructor_count();
+    if (auto *state = runtime_bindings()) {
+      statistics.bindings = registered_bindings(*state).size();
+      state->lookup_indexes.for_each_value_count([&](std::size_t count) {
+        statistics.lookup_bindings.push_back(count);
+      });
+    }
+  }
+
   template <typename Source> class container_proxy {
   public:
     using container_type = typename Source::container_type;
@@ -1094,6 +1254,20 @@ protected:
     }
   };
 
+  // The cache key of a warmed binding is chosen by the binding itself.
+  struct warm_up_update {
+    cache_update cache;
+    detail::warm_up_result *result;
+
+    detail::cache::sink sink() noexcept { return {this, &publish}; }
+
+    static void publish(void *state, void *address) {
+      auto &update = *reinterpret_cast<warm_up_update *>(state);
+      update.cache.key = update.result->cache_key;
+      cache_update::publish(std::addressof(update.cache), address);
+    }
+  };
+
   template <typename Request, bool MayAutoConstruct, typename LookupKey>
   struct missing_runtime_binding {
     registry_type &registry;
@@ -1221,6 +1395,26 @@ protected:
     return result;
   }
 
+  // Appends the member bindings of collection `T` without resolving them.
+  template <typename T, typename Bindings, typename LookupKey,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  std::size_t append_collection_bindings(Bindings &bindings, LookupKey key) {
+    auto *state = runtime_bindings();
+    if (!state) {
+      return 0;
+    }
+    return for_each_collection_entry<T>(*state, key, [&](auto &entry) {
+      bindings.push_back(std::addressof(entry.binding()));
+    });
+  }
+
+  template <typename T>
+  T resolve_collection_binding(construction_scope scope,
+                               runtime_binding_interface_type &binding,
+                               runtime_context_type &context) {
+    return resolve_collection_type<T>(scope, binding, context);
+  }
+
 private:
   template <typename Request, typename LookupKey>
   runtime_selection select_binding(runtime_bindings_state &state,
@@ -1288,6 +1482,14 @@ private:
   template <typename LookupEntry, typename Key>
   runtime_selection select_lookup(runtime_bindings_state &state,
                                   const Key &key) {
+    if constexpr (frozen_index_type::template contains_v<LookupEntry>) {
+      if (state.frozen != nullptr) {
+        auto match =
+            detail::lookup_find_singular<LookupEntry, runtime_lookup_value>(
+                state.frozen->template get<LookupEntry>(), key);
+        return make_selection(match.value, match.ambiguous);
+      }
+    }
     auto &index = state.lookup_indexes.template get<LookupEntry>();
     auto match =
         detail::lookup_find_singular<LookupEntry, runtime_lookup_value>(index,
@@ -1298,6 +1500,13 @@ private:
   template <typename LookupEntry, typename Key, typename Fn>
   std::size_t for_each_lookup(runtime_bindings_state &state, const Key &key,
                               Fn &&fn) {
+    if constexpr (frozen_index_type::template contains_v<LookupEntry>) {
+      if (state.frozen != nullptr) {
+        return detail::lookup_for_each<LookupEntry>(
+            state.frozen->template get<LookupEntry>(), key,
+            std::forward<Fn>(fn));
+      }
+    }
     auto &index = state.lookup_indexes.template get<LookupEntry>();
     return detail::lookup_for_each<LookupEntry>(index, key,
                                                 std::forward<Fn>(fn));
@@ -1361,6 +1570,10 @@ private:
     using instance_container_type =
         registration_container_type<bindings_type, Parent>;
     (void)std::addressof(arg);
+    // Registration containers have no lock of their own and change the
+    // root's runtime data, so they register under the root's scope, which
+    // also rejects registrations once the root is frozen.
+    [[maybe_unused]] auto root_scope = registration_root_scope();
     using interface_types = typename binding_model::interface_types;
     static constexpr bool storage_tag_is_complete =
         binding_model::storage_tag_is_complete;
@@ -1536,6 +1749,7 @@ private:
     auto handle = insert_lookup<TypeInterface, TypeStorage, LookupKey, Head>(
         state, value_factory, lookup_key, key_arg);
     record_lookup_rollback<Head>(transaction, state, handle, key_arg);
+    record_lookup_commit<Head>(transaction, state);
     commit_lookup<TypeInterface, TypeStorage, LookupKey>(
         state, value_factory, transaction,
         std::forward<KeyResolver>(key_resolver), lookup_key,
@@ -1587,6 +1801,16 @@ private:
     }
   }
 
+  template <typename LookupEntry>
+  static void record_lookup_commit(runtime_transaction_type &transaction,
+                                   runtime_bindings_state &state) {
+    auto &index = state.lookup_indexes.template get<LookupEntry>();
+    if constexpr (detail::has_lookup_storage_commit_v<
+                      std::remove_reference_t<decltype(index)>>) {
+      transaction.on_commit([&index]() noexcept { index.commit(); });
+    }
+  }
+
   bool commit_singular_base_lookup(runtime_bindings_state &state,
                                    runtime_transaction_type &transaction,
                                    detail::base_lookup_key<rtti_type> key,
@@ -1596,6 +1820,7 @@ private:
     if (inserted) {
       record_lookup_rollback<base_lookup_entry>(transaction, state, handle,
                                                 key);
+      record_lookup_commit<base_lookup_entry>(transaction, state);
     }
     return inserted;
   }
@@ -0,0 +1,132 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+#include <dingo/memory/arena_allocator.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace dingo {
+
+// Scratch memory shared by the resolutions a thread runs while the session is
+// alive. Without a session every top-level resolve starts from a small stack
+// buffer and releases the heap blocks it grew. A session keeps one buffer that
+// each outermost resolve rewinds; when a resolve outgrows it, the buffer is
+// enlarged to the observed high-water mark once the outermost resolve
+// finishes, so repeated resolves of the same graph stop allocating.
+//
+// Sessions install themselves for the constructing thread and must be
+// destroyed on that thread in reverse order of construction.
+class resolution_session {
+  using buffer_type = std::max_align_t;
+
+public:
+  // Only the outermost scope rewinds. A nested resolve can add rollback
+  // actions of an enclosing transaction to the scratch, so its memory stays
+  // until the outermost resolve finishes.
+  class scope {
+  public:
+    explicit scope(resolution_session &session) noexcept : session_(session) {
+      ++session_.depth_;
+    }
+
+    ~scope() {
+      if (--session_.depth_ == 0) {
+        session_.finish();
+      }
+    }
+
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+
+    arena<> &scratch() noexcept { return *session_.scratch_; }
+
+  private:
+    resolution_session &session_;
+  };
+
+  explicit resolution_session(
+      std::size_t capacity = DINGO_CONTEXT_ARENA_BUFFER_SIZE)
+      : previous_(current_session()) {
+    allocate(capacity);
+    current_session() = this;
+  }
+
+  ~resolution_session() {
+    assert(current_session() == this);
+    assert(depth_ == 0);
+    current_session() = previous_;
+  }
+
+  resolution_session(const resolution_session &) = delete;
+  resolution_session &operator=(const resolution_session &) = delete;
+
+  static resolution_session *current() noexcept { return current_session(); }
+
+  // Bytes of scratch available before a resolve falls back to heap blocks.
+  std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+  static resolution_session *&current_session() noexcept {
+    static thread_local resolution_session *session = nullptr;
+    return session;
+  }
+
+  // The arena keeps its block header at the start of the buffer. Padding
+  // after it is already counted in the measured high-water mark.
+  static constexpr std::size_t header_size() {
+    return arena<>::block_header_size();
+  }
+
+  void allocate(std::size_t capacity) {
+    const auto count = (capacity + header_size() + sizeof(buffer_type) - 1) /
+                       sizeof(buffer_type);
+    auto buffer = std::make_unique<buffer_type[]>(count);
+    scratch_.reset();
+    scratch_.emplace(buffer.get(), count * sizeof(buffer_type),
+                     DINGO_CONTEXT_ARENA_BUFFER_SIZE);
+    buffer_ = std::move(buffer);
+    base_ = scratch_->mark();
+    capacity_ = capacity;
+  }
+
+  void finish() noexcept {
+    auto &scratch = *scratch_;
+    if (scratch.mark().head != base_.head) {
+      required_ = std::max(required_, scratch.used_since(base_));
+    }
+    scratch.rewind(base_);
+    if (required_ > capacity_) {
+      grow();
+    }
+  }
+
+  void grow() noexcept {
+    try {
+      allocate(std::max(required_, capacity_ * 2));
+    } catch (...) {
+      // Keep the current buffer; resolves still fall back to heap blocks.
+      required_ = capacity_;
+    }
+  }
+
+  std::unique_ptr<buffer_type[]> buffer_;
+  std::optional<arena<>> scratch_;
+  arena<>::checkpoint base_{};
+  std::size_t capacity_ = 0;
+  std::size_t required_ = 0;
+  std::size_t depth_ = 0;
+  resolution_session *previous_;
+};
+
+} // namespace dingo
@@ -0,0 +1,133 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+// Statistics are not collected and `statistics()` is not available.
+struct no_statistics {};
+
+// The container counts cache hits, misses and rolled back resolutions and
+// exposes them, with its memory usage, through `statistics()`.
+struct collect_statistics {};
+
+// Snapshot returned by `container.statistics()`.
+struct container_statistics {
+  // Runtime bindings registered in the container.
+  std::size_t bindings = 0;
+  // Values held by each lookup index, in lookup declaration order. A binding
+  // registered for several interfaces is counted once per interface.
+  std::vector<std::size_t> lookup_bindings;
+  // Bytes of the instance arena obtained from the allocator, and the part of
+  // them handed out, including alignment padding.
+  std::size_t arena_reserved = 0;
+  std::size_t arena_used = 0;
+  // Entries of the destructor journal that runs when the container is
+  // destroyed. The journal is a linked list walked when the snapshot is
+  // taken, so this is O(n) in the number of entries.
+  std::size_t destructors = 0;
+  // Cacheable resolve calls served from a cached address, and those that
+  // entered a transaction.
+  std::size_t cache_hits = 0;
+  std::size_t cache_misses = 0;
+  // Outermost resolve calls whose transaction was rolled back by an exception.
+  // A failure in a nested resolution counts once, for the call that started
+  // the transaction. Lookups of unregistered types run in a transaction too,
+  // so each failed lookup counts.
+  std::size_t rollbacks = 0;
+  // Outermost transactions opened by the container. A cache hit opens none,
+  // and `resolve_all()` opens one for the whole batch.
+  std::size_t transactions = 0;
+};
+
+namespace detail {
+template <typename T, typename = void> struct container_statistics_type {
+  using type = no_statistics;
+};
+
+template <typename T>
+struct container_statistics_type<T,
+                                 std::void_t<typename T::statistics_type>> {
+  using type = typename T::statistics_type;
+};
+
+template <typename T>
+using container_statistics_type_t =
+    typename container_statistics_type<T>::type;
+
+template <typename Statistics> class statistics_counters;
+
+template <> class statistics_counters<no_statistics> {
+public:
+  static constexpr bool enabled = false;
+
+  class rollback_scope {
+  public:
+    rollback_scope(statistics_counters &, bool) {}
+  };
+
+  void cache_hit() {}
+  void cache_miss() {}
+  void transaction() {}
+};
+
+template <> class statistics_counters<collect_statistics> {
+public:
+  static constexpr bool enabled = true;
+
+  // Counts a rollback when the guarded resolve call exits by an exception.
+  // Only a call made while no transaction of the container is active counts,
+  // so a failure propagating through nested resolve calls counts once.
+  class rollback_scope {
+  public:
+    rollback_scope(statistics_counters &counters, bool outermost)
+        : counters_(counters),
+          exceptions_(outermost ? std::uncaught_exceptions() : -1) {}
+
+    rollback_scope(const rollback_scope &) = delete;
+    rollback_scope &operator=(const rollback_scope &) = delete;
+
+    ~rollback_scope() {
+      if (exceptions_ >= 0 && std::uncaught_exceptions() != exceptions_) {
+        counters_.rollbacks_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    statistics_counters &counters_;
+    int exceptions_;
+  };
+
+  void cache_hit() { hits_.fetch_add(1, std::memory_order_relaxed); }
+  void cache_miss() { misses_.fetch_add(1, std::memory_order_relaxed); }
+  void transaction() {
+    transactions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void fill(container_statistics &statistics) const {
+    statistics.cache_hits = hits_.load(std::memory_order_relaxed);
+    statistics.cache_misses = misses_.load(std::memory_order_relaxed);
+    statistics.rollbacks = rollbacks_.load(std::memory_order_relaxed);
+    statistics.transactions = transactions_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::size_t> hits_{0};
+  std::atomic<std::size_t> misses_{0};
+  std::atomic<std::size_t> rollbacks_{0};
+  std::atomic<std::size_t> transactions_{0};
+};
+} // namespace detail
+} // namespace dingo
@@ -7,29 +7,71 @@
 
 #pragma once
 
+#include <dingo/core/binding_handle.h>
+#include <dingo/core/collection_view.h>
+#include <dingo/core/lazy_collection.h>
+#include <dingo/core/warm_up.h>
+#include <dingo/runtime/collection_cache.h>
+#include <dingo/runtime/concurrency.h>
 #include <dingo/runtime/container_traits.h>
+#include <dingo/runtime/observer.h>
+#include <dingo/runtime/parallel_collection.h>
 #include <dingo/runtime/registration_api.h>
 #include <dingo/runtime/registry.h>
+#include <dingo/runtime/statistics.h>
 #include <dingo/type/dependency_traits.h>
 
+#include <array>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4702)
 #endif
 
 namespace dingo {
+template <typename ContainerTraits, typename Allocator,
+          typename ParentContainer>
+class runtime_container;
+
+namespace detail {
+template <typename ContainerTraits, typename Allocator,
+          typename ParentContainer>
+std::true_type is_runtime_container_impl(
+    const runtime_container<ContainerTraits, Allocator, ParentContainer> *);
+std::false_type is_runtime_container_impl(...);
+
+template <typename T>
+inline constexpr bool is_runtime_container_v =
+    decltype(is_runtime_container_impl(std::declval<T *>()))::value;
+
+template <typename T, typename LookupKey> struct collection_view_tag {};
+} // namespace detail
 
 template <typename ContainerTraits = dynamic_container_traits,
           typename Allocator = typename ContainerTraits::allocator_type,
           typename ParentContainer = void>
 class runtime_container
     : public detail::runtime_registration_api<
-          runtime_container<ContainerTraits, Allocator, ParentContainer>> {
+          runtime_container<ContainerTraits, Allocator, ParentContainer>>,
+      detail::resolution_snapshot<
+          detail::container_concurrency_type_t<ContainerTraits>, Allocator>,
+      detail::statistics_counters<
+          detail::container_statistics_type_t<ContainerTraits>> {
   using self_type =
       runtime_container<ContainerTraits, Allocator, ParentContainer>;
   using registry_base =
       runtime_registry<ContainerTraits, Allocator, void, self_type>;
   using runtime_context_type = runtime_context<Allocator>;
+  using resolution_snapshot_type = detail::resolution_snapshot<
+      detail::container_concurrency_type_t<ContainerTraits>, Allocator>;
+  using observer_type = detail::container_observer_type_t<ContainerTraits>;
+  using statistics_counters_type = detail::statistics_counters<
+      detail::container_statistics_type_t<ContainerTraits>>;
 
   template <typename> friend class runtime_context;
   template <typename, typename> friend class detail::binding_resolution;
@@ -37,6 +79,7 @@ class runtime_container
   friend class detail::container_with_static_bindings;
   template <typename, typename, typename, typename, bool>
   friend class runtime_registry;
+  template <typename, typename, typename> friend class runtime_container;
 
 public:
   using container_traits_type = ContainerTraits;
@@ -56,16 +99,28 @@ public:
   using rebind_t =
       runtime_container<ContainerTraitsT, AllocatorT, ParentContainerT>;
 
-  runtime_container() : runtime_registry_(detail::runtime_data_owner, this) {}
+  runtime_container()
+      : resolution_snapshot_type(allocator_type()),
+        runtime_registry_(detail::runtime_data_owner, this) {}
 
   explicit runtime_container(const allocator_type &alloc)
-      : runtime_registry_(detail::runtime_data_owner, this, alloc) {}
+      : resolution_snapshot_type(alloc),
+        runtime_registry_(detail::runtime_data_owner, this, alloc) {}
 
   runtime_container(parent_container_type *parent,
                     const allocator_type &alloc = allocator_type())
-      : runtime_registry_(detail::runtime_data_owner, this, alloc),
+      : resolution_snapshot_type(alloc),
+        runtime_registry_(detail::runtime_data_owner, this, alloc),
         parent_(parent) {}
 
+  ~runtime_container() {
+    if (collections_) {
+      collection_cache_allocator allocator(runtime_registry_.get_allocator());
+      collection_cache_traits::destroy(allocator, collections_);
+      collection_cache_traits::deallocate(allocator, collections_, 1);
+    }
+  }
+
 private:
   template <typename Request, typename Origin, typename LookupKey,
             typename R = typename Request::lookup_type,
@@ -245,6 +300,7 @@ private:
 public:
   template <typename T, typename IdType>
   detail::binding_status binding_status(IdType &&id) {
+    [[maybe_unused]] auto lock = snapshot().lock();
     using request = request_type<T>;
     auto key = detail::make_lookup_key(std::forward<IdType>(id));
     auto status = runtime_registry_.template binding_status<T>(key);
@@ -261,43 +317,202 @@ private:
   DINGO_NOINLINE R
   resolve_selected(typename registry_type::runtime_selection selection) {
     using interface_type = typename Request::interface_type;
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) -> R {
-          return runtime_registry_.template resolve_binding<interface_type, R>(
-              selection, ephemeral_scope, context);
-        });
+    return run_transaction([&](runtime_context_type &context) -> R {
+      return runtime_registry_.template resolve_binding<interface_type, R>(
+          selection, ephemeral_scope, context);
+    });
+  }
+
+  // Requests whose resolved address is published to the snapshot.
+  template <typename Request, typename R, typename LookupKey>
+  static constexpr bool is_published() {
+    return resolution_snapshot_type::enabled &&
+           detail::cache::supports_v<typename Request::interface_type> &&
+           !collection_traits<R>::is_collection &&
+           detail::is_no_lookup_key_v<LookupKey>;
   }
 
   template <typename Request, bool MayAutoConstruct, typename R,
             typename LookupKey>
   R resolve_entry(LookupKey key) {
     using interface_type = typename Request::interface_type;
-    if constexpr (detail::cache::supports_v<interface_type> &&
-                  !collection_traits<R>::is_collection) {
+    detail::resolve_observation<observer_type> observation(
+        describe_type<typename Request::user_type>());
+    if constexpr (is_published<Request, R, LookupKey>()) {
+      void *address = nullptr;
+      if (snapshot().find(detail::cache::key<Request>(), address)) {
+        counters().cache_hit();
+        detail::observe_cache_hit<observer_type>(
+            describe_type<typename Request::user_type>());
+        return registry_type::template resolve_cached<interface_type, R>(
+            {true, address});
+      }
+      [[maybe_unused]] auto lock = snapshot().lock();
+      // The transaction state is only read under the lock.
+      typename statistics_counters_type::rollback_scope rollback(
+          counters(), !runtime_registry_.runtime().in_transaction());
       auto selection =
           runtime_registry_
               .template select_binding<typename Request::lookup_type>(key);
-      auto result =
-          runtime_registry_.template lookup_cache<interface_type>(selection);
-      if (result.hit) {
-        return runtime_registry_.template resolve_cached<interface_type, R>(
-            result);
-      }
-      if (selection.status == detail::binding_status::found) {
-        return resolve_selected<Request, R>(selection);
+      R result = resolve_selected_entry<Request, MayAutoConstruct, R>(
+          selection, std::move(key));
+      publish_selection<Request>(selection);
+      return result;
+    } else {
+      [[maybe_unused]] auto lock = snapshot().lock();
+      typename statistics_counters_type::rollback_scope rollback(
+          counters(), !runtime_registry_.runtime().in_transaction());
+      return resolve_selected_entry<Request, MayAutoConstruct, R>(
+          std::move(key));
+    }
+  }
+
+  // Publishes the binding cache entry that a successful resolution of the
+  // selected binding filled, so that concurrent readers can resolve the
+  // request without locking. Inside a transaction the entry could still be
+  // rolled back, so publishing waits for the outermost call.
+  template <typename Request>
+  void publish_selection(typename registry_type::runtime_selection selection) {
+    if (runtime_registry_.runtime().in_transaction()) {
+      return;
+    }
+    auto result = runtime_registry_
+                      .template lookup_cache<typename Request::interface_type>(
+                          selection);
+    if (result.hit) {
+      snapshot().publish(detail::cache::key<Request>(), result.address);
+    }
+  }
+
+  // Resolves a request of resolve_all() in the context of the batch and
+  // records the binding it selected for publish_batched().
+  template <typename T, typename LookupKey>
+  typename request_type<T, true>::result_type
+  resolve_batched(runtime_context_type &context,
+                  typename registry_type::runtime_selection &selection,
+                  LookupKey key) {
+    using request = request_type<T>;
+    using interface_type = typename request::interface_type;
+    using result_type = typename request_type<T, true>::result_type;
+    constexpr bool may_auto_construct =
+        detail::is_runtime_auto_constructible_dependency_v<T>;
+    if constexpr (detail::is_lazy_collection_v<T>) {
+      (void)context;
+      (void)selection;
+      return resolve_lazy<typename result_type::value_type>(std::move(key));
+    } else {
+      detail::resolve_observation<observer_type> observation(
+          describe_type<typename request::user_type>());
+      if constexpr (detail::cache::supports_v<interface_type> &&
+                    !collection_traits<result_type>::is_collection) {
+        selection =
+            runtime_registry_
+                .template select_binding<typename request::lookup_type>(key);
+        auto result =
+            runtime_registry_.template lookup_cache<interface_type>(selection);
+        if (result.hit) {
+          counters().cache_hit();
+          detail::observe_cache_hit<observer_type>(
+              describe_type<typename request::user_type>());
+          return runtime_registry_
+              .template resolve_cached<interface_type, result_type>(result);
+        }
+        counters().cache_miss();
+        return resolve_request<request, may_auto_construct, result_type>(
+            selection, ephemeral_scope, context, *this, key);
+      } else {
+        (void)selection;
+        return resolve_request<request, may_auto_construct, result_type>(
+            ephemeral_scope, context, *this, key);
       }
-      return execute_transaction(
-          runtime_registry_.runtime(), [&](runtime_context_type &context) -> R {
-            return resolve_request<Request, MayAutoConstruct, R>(
-                selection, ephemeral_scope, context, *this, std::move(key));
-          });
     }
+  }
 
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) -> R {
-          return resolve_request<Request, MayAutoConstruct, R>(
-              ephemeral_scope, context, *this, std::move(key));
+  // Publishes a request of resolve_all() once the batch has committed.
+  template <typename T>
+  void publish_batched(typename registry_type::runtime_selection selection) {
+    using request = request_type<T>;
+    using result_type = typename request_type<T, true>::result_type;
+    using key_type = decltype(detail::no_lookup_key());
+    if constexpr (!detail::is_lazy_collection_v<T> &&
+                  is_published<request, result_type, key_type>()) {
+      publish_selection<request>(selection);
+    } else {
+      (void)selection;
+    }
+  }
+
+  template <typename... Ts, std::size_t... Is>
+  std::tuple<typename request_type<Ts, true>::result_type...>
+  resolve_all_batch(std::index_sequence<Is...>) {
+    using result_type =
+        std::tuple<typename request_type<Ts, true>::result_type...>;
+    [[maybe_unused]] auto lock = snapshot().lock();
+    typename statistics_counters_type::rollback_scope rollback(
+        counters(), !runtime_registry_.runtime().in_transaction());
+    std::array<typename registry_type::runtime_selection, sizeof...(Ts)>
+        selections{};
+    auto values =
+        run_transaction([&](runtime_context_type &context) -> result_type {
+          return result_type{
+              resolve_batched<Ts>(context, std::get<Is>(selections),
+                                  detail::no_lookup_key())...};
         });
+    (publish_batched<Ts>(std::get<Is>(selections)), ...);
+    return values;
+  }
+
+  // Runs `fn` in a transaction of the container runtime, counting it when it
+  // is the outermost one. Callers hold the snapshot lock.
+  template <typename Fn> decltype(auto) run_transaction(Fn &&fn) {
+    if (!runtime_registry_.runtime().in_transaction()) {
+      counters().transaction();
+    }
+    return execute_transaction(runtime_registry_.runtime(),
+                               std::forward<Fn>(fn));
+  }
+
+  template <typename Request, bool MayAutoConstruct, typename R,
+            typename LookupKey>
+  R resolve_selected_entry(LookupKey key) {
+    using interface_type = typename Request::interface_type;
+    if constexpr (detail::cache::supports_v<interface_type> &&
+                  !collection_traits<R>::is_collection) {
+      auto selection =
+          runtime_registry_
+              .template select_binding<typename Request::lookup_type>(key);
+      return resolve_selected_entry<Request, MayAutoConstruct, R>(
+          selection, std::move(key));
+    }
+
+    return run_transaction([&](runtime_context_type &context) -> R {
+      return resolve_request<Request, MayAutoConstruct, R>(
+          ephemeral_scope, context, *this, std::move(key));
+    });
+  }
+
+  template <typename Request, bool MayAutoConstruct, typename R,
+            typename LookupKey>
+  R resolve_selected_entry(typename registry_type::runtime_selection selection,
+                           LookupKey key) {
+    using interface_type = typename Request::interface_type;
+    auto result =
+        runtime_registry_.template lookup_cache<interface_type>(selection);
+    if (result.hit) {
+      counters().cache_hit();
+      detail::observe_cache_hit<observer_type>(
+          describe_type<typename Request::user_type>());
+      return runtime_registry_.template resolve_cached<interface_type, R>(
+          result);
+    }
+    counters().cache_miss();
+    if (selection.status == detail::binding_status::found) {
+      return resolve_selected<Request, R>(selection);
+    }
+    return run_transaction([&](runtime_context_type &context) -> R {
+      return resolve_request<Request, MayAutoConstruct, R>(
+          selection, ephemeral_scope, context, *this, std::move(key));
+    });
   }
 
   template <typename Request, bool MayAutoConstruct, typename R,
@@ -320,9 +535,13 @@ public:
   R resolve(IdType &&id = IdType()) {
     using request = request_type<T>;
     auto key = detail::make_lookup_key(std::forward<IdType>(id));
-    return resolve_entry<
-        request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
-        std::move(key));
+    if constexpr (detail::is_lazy_collection_v<T>) {
+      return resolve_lazy<typename R::value_type>(std::move(key));
+    } else {
+      return resolve_entry<
+          request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
+          std::move(key));
+    }
   }
 
   template <typename T, typename LookupKey,
@@ -330,9 +549,154 @@ public:
             std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
   R resolve(LookupKey key) {
     using request = request_type<T>;
-    return resolve_entry<
-        request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
-        std::move(key));
+    if constexpr (detail::is_lazy_collection_v<T>) {
+      return resolve_lazy<typename R::value_type>(std::move(key));
+    } else {
+      return resolve_entry<
+          request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
+          std::move(key));
+    }
+  }
+
+  // Resolves all requests in one transaction, in order. If a request throws,
+  // instances constructed for the earlier ones are rolled back with it.
+  template <typename... Ts>
+  std::tuple<typename request_type<Ts, true>::result_type...> resolve_all() {
+    return resolve_all_batch<Ts...>(std::index_sequence_for<Ts...>{});
+  }
+
+  // Resolves `T` for every runtime key in [first, last) in one transaction
+  // and writes the results to `out`.
+  template <typename T, typename InputIt, typename OutputIt>
+  OutputIt resolve_all(InputIt first, InputIt last, OutputIt out) {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    typename statistics_counters_type::rollback_scope rollback(
+        counters(), !runtime_registry_.runtime().in_transaction());
+    return run_transaction([&](runtime_context_type &context) -> OutputIt {
+      typename registry_type::runtime_selection selection;
+      for (; first != last; ++first) {
+        *out = resolve_batched<T>(context, selection,
+                                  detail::make_lookup_key(*first));
+        ++out;
+      }
+      return out;
+    });
+  }
+
+  // Resolves `T` once and returns a handle to its address. The binding must
+  // keep a stable address (shared or external storage).
+  template <typename T, typename IdType = none_t,
+            typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<!detail::is_lookup_key_v<IdType>, int> = 0>
+  binding_handle<R> handle(IdType &&id = IdType()) {
+    return handle<T>(detail::make_lookup_key(std::forward<IdType>(id)));
+  }
+
+  template <typename T, typename LookupKey,
+            typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  binding_handle<R> handle(LookupKey key) {
+    using request = request_type<T>;
+    using lookup_type = typename request::lookup_type;
+    static_assert(detail::cache::supports_v<R> &&
+                      !collection_traits<R>::is_collection,
+                  "binding handle requires a reference or pointer request");
+    [[maybe_unused]] auto lock = snapshot().lock();
+    auto selection =
+        runtime_registry_.template select_binding<lookup_type>(key);
+    if constexpr (can_resolve_from_parent<request, LookupKey>()) {
+      if (parent_ && selection.status == detail::binding_status::not_found) {
+        return parent_->template handle<T>(std::move(key));
+      }
+    }
+    runtime_registry_.template check_stable_binding<lookup_type>(selection);
+    return binding_handle<R>(resolve<T>(std::move(key)));
+  }
+
+  // Resolves the collection of `T` elements once and returns a view of it.
+  // Later calls return the same elements without resolving or allocating
+  // until a registration in this container or its parents changes what the
+  // collection may hold. The next call then frees the old elements, which
+  // ends the views returned before. Every element must come from stable
+  // storage.
+  template <typename T, typename IdType = none_t,
+            std::enable_if_t<!detail::is_lookup_key_v<IdType>, int> = 0>
+  collection_view<T> view(IdType &&id = IdType()) {
+    return view<T>(detail::make_lookup_key(std::forward<IdType>(id)));
+  }
+
+  template <typename T, typename LookupKey,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  collection_view<T> view(LookupKey key) {
+    static_assert(std::is_pointer_v<T>,
+                  "collection view requires a pointer element type");
+    static_assert(detail::is_static_lookup_key_definition_v<LookupKey>,
+                  "collection view requires a key fixed in its type");
+    using collection_type = std::vector<T>;
+    using request = request_type<collection_type>;
+    const auto type = rtti_type::template get_type_index<
+        detail::collection_view_tag<T, LookupKey>>();
+    [[maybe_unused]] auto lock = snapshot().lock();
+    const auto generation = collection_generation();
+    collection_view<T> result;
+    if (collections_ && collections_->find(type, generation, result)) {
+      return result;
+    }
+    check_stable_collection<collection_type>(key);
+    auto values = run_transaction(
+        [&](runtime_context_type &context) -> collection_type {
+          return resolve_request<request, false, collection_type>(
+              ephemeral_scope, context, *this, key);
+        });
+    return collection_cache().template store<T>(type, generation, values);
+  }
+
+  // Materializes the shared bindings registered in this container in one
+  // transaction and reports how long each took, so later requests only hit
+  // the cache. `warm_up<Interfaces...>()` restricts it to bindings registered
+  // for the given interfaces.
+  template <typename... Interfaces> warm_up_report warm_up() {
+    const auto filter = detail::warm_up_interfaces<Interfaces...>::filter();
+    warm_up_report report;
+    [[maybe_unused]] auto lock = snapshot().lock();
+    run_transaction([&](runtime_context_type &context) {
+      runtime_registry_.warm_up(context, filter, report);
+    });
+    return report;
+  }
+
+  // Reserves memory for about `count` runtime registrations up front, so
+  // that registering them does not request many small arena blocks.
+  void reserve_bindings(std::size_t count) {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    runtime_registry_.reserve_bindings(count);
+  }
+
+  // Compiles the lookups into contiguous read-only tables once registration
+  // is over. Further registrations throw container_frozen_exception, so with
+  // `concurrent` traits the published resolutions are never invalidated and
+  // repeated stable requests stay lock-free.
+  void freeze() {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    runtime_registry_.freeze();
+  }
+
+  bool frozen() {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    return runtime_registry_.frozen();
+  }
+
+  // Returns a snapshot of the binding counts, memory usage and resolution
+  // counters. Requires `statistics_type = collect_statistics` in the traits.
+  container_statistics statistics() {
+    static_assert(statistics_counters_type::enabled,
+                  "statistics() requires container traits with "
+                  "statistics_type = dingo::collect_statistics");
+    container_statistics result;
+    [[maybe_unused]] auto lock = snapshot().lock();
+    runtime_registry_.statistics(result);
+    counters().fill(result);
+    return result;
   }
 
   template <typename T, bool RemoveRvalueReferences, typename LookupKey,
@@ -359,6 +723,8 @@ public:
           request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
           scope, context, origin, std::move(key));
     }
+    // A child continuing into this container holds only its own lock.
+    [[maybe_unused]] auto lock = snapshot().lock();
     return resolve_nested<
         request, detail::is_runtime_auto_constructible_dependency_v<T>, R>(
         scope, context, origin, std::move(key));
@@ -385,11 +751,11 @@ public:
   template <typename T, typename Factory = constructor<normalized_type_t<T>>,
             typename R = typename request_type<T, true>::result_type>
   R construct(Factory factory = Factory()) {
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) -> R {
-          return construct_request<request_type<T>, Factory, R>(
-              ephemeral_scope, context, std::move(factory));
-        });
+    [[maybe_unused]] auto lock = snapshot().lock();
+    return run_transaction([&](runtime_context_type &context) -> R {
+      return construct_request<request_type<T>, Factory, R>(
+          ephemeral_scope, context, std::move(factory));
+    });
   }
 
   template <typename T> T construct_collection() {
@@ -407,22 +773,22 @@ public:
   template <typename T, typename LookupKey,
             std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
   T construct_collection(LookupKey key) {
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) -> T {
-          return runtime_registry_.template construct_collection<T>(
-              ephemeral_scope, context, detail::binding_collection_append{},
-              std::move(key));
-        });
+    [[maybe_unused]] auto lock = snapshot().lock();
+    return run_transaction([&](runtime_context_type &context) -> T {
+      return runtime_registry_.template construct_collection<T>(
+          ephemeral_scope, context, detail::binding_collection_append{},
+          std::move(key));
+    });
   }
 
   template <typename T, typename Fn, typename LookupKey,
             std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
   T construct_collection(Fn &&fn, LookupKey key) {
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) -> T {
-          return runtime_registry_.template construct_collection<T>(
-              ephemeral_scope, context, std::forward<Fn>(fn), std::move(key));
-        });
+    [[maybe_unused]] auto lock = snapshot().lock();
+    return run_transaction([&](runtime_context_type &context) -> T {
+      return runtime_registry_.template construct_collection<T>(
+          ephemeral_scope, context, std::forward<Fn>(fn), std::move(key));
+    });
   }
 
   template <typename T, typename Key> T construct_collection(key_type<Key>) {
@@ -440,13 +806,54 @@ public:
                                    detail::no_lookup_key());
   }
 
+  // Constructs the collection members as tasks handed to `executor`, a
+  // callable accepting a `void()` task. Tasks run in one transaction; a
+  // failing member discards the others and rolls back the resolution.
+  // The calling thread holds the container lock while it waits, so member
+  // constructors must take their dependencies as arguments: calling into
+  // the container from a member deadlocks, which debug builds assert.
+  template <typename T, typename Executor>
+  T construct_collection_parallel(Executor &&executor) {
+    return construct_collection_parallel<T>(std::forward<Executor>(executor),
+                                            detail::no_lookup_key());
+  }
+
+  template <typename T, typename Executor, typename Key>
+  T construct_collection_parallel(Executor &&executor, key_type<Key>) {
+    return construct_collection_parallel<T>(
+        std::forward<Executor>(executor),
+        detail::make_lookup_key(key_type<Key>{}));
+  }
+
+  template <typename T, typename Executor, typename LookupKey,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  T construct_collection_parallel(Executor &&executor, LookupKey key) {
+    using resolve_type = typename collection_traits<T>::resolve_type;
+    [[maybe_unused]] auto lock = snapshot().lock();
+    std::vector<void *> bindings;
+    runtime_registry_.template append_collection_bindings<T>(bindings, key);
+    if (bindings.empty() &&
+        !registry_type::template has_explicit_collection_lookup<T>(key)) {
+      throw detail::make_collection_type_not_found_exception<T,
+                                                             resolve_type>();
+    }
+    return run_transaction([&](runtime_context_type &context) -> T {
+      detail::parallel_collection<resolve_type> members(
+          this, &context, &construct_parallel_member<resolve_type>, bindings);
+      members.execute(executor);
+      T results;
+      members.collect(results);
+      return results;
+    });
+  }
+
   template <typename Signature = void, typename Callable>
   auto invoke(Callable &&callable) {
-    return execute_transaction(
-        runtime_registry_.runtime(), [&](runtime_context_type &context) {
-          return runtime_registry_.template invoke<Signature>(
-              context, std::forward<Callable>(callable));
-        });
+    [[maybe_unused]] auto lock = snapshot().lock();
+    return run_transaction([&](runtime_context_type &context) {
+      return runtime_registry_.template invoke<Signature>(
+          context, std::forward<Callable>(callable));
+    });
   }
 
 private:
@@ -454,16 +861,155 @@ private:
 
   registry_type &binding_store() { return runtime_registry_; }
 
+  // The single-threaded snapshot is empty and is kept as a base so that it
+  // does not grow the container.
+  resolution_snapshot_type &snapshot() { return *this; }
+
+  // Likewise empty unless the traits collect statistics.
+  statistics_counters_type &counters() { return *this; }
+
+  // Registrations can change what a request selects, so they drop the
+  // published resolutions and run under the container lock.
+  auto registration_scope() {
+    auto lock = snapshot().lock();
+    if (runtime_registry_.frozen()) {
+      throw detail::make_container_frozen_exception();
+    }
+    snapshot().invalidate();
+    if (collections_) {
+      collections_->invalidate();
+    }
+    return lock;
+  }
+
+  using collection_cache_type =
+      detail::collection_cache<typename rtti_type::type_index, allocator_type>;
+  using collection_cache_allocator = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<collection_cache_type>;
+  using collection_cache_traits =
+      std::allocator_traits<collection_cache_allocator>;
+
+  collection_cache_type &collection_cache() {
+    if (!collections_) {
+      auto &allocator = runtime_registry_.get_allocator();
+      collection_cache_allocator cache_allocator(allocator);
+      auto *cache = collection_cache_traits::allocate(cache_allocator, 1);
+      try {
+        collection_cache_traits::construct(cache_allocator, cache, allocator);
+      } catch (...) {
+        collection_cache_traits::deallocate(cache_allocator, cache, 1);
+        throw;
+      }
+      collections_ = cache;
+    }
+    return *collections_;
+  }
+
+  // Changes whenever a registration in this container or a runtime parent
+  // may change a collection. Parents must have a cache to count theirs, and a
+  // child reaches here under its own lock only, so the parent's is taken.
+  std::size_t collection_generation() {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    std::size_t generation = collection_cache().generation();
+    if constexpr (has_parent_v &&
+                  detail::is_runtime_container_v<parent_container_type>) {
+      if (parent_) {
+        generation += parent_->collection_generation();
+      }
+    }
+    return generation;
+  }
+
+  // Selects the members of a lazy collection now and resolves each one when
+  // it is dereferenced, in its own transaction.
+  template <typename T, typename LookupKey>
+  lazy_collection<T> resolve_lazy(LookupKey key) {
+    using collection_type = std::vector<T>;
+    using bindings_allocator = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<void *>;
+    [[maybe_unused]] auto lock = snapshot().lock();
+    std::vector<void *, bindings_allocator> bindings(
+        bindings_allocator(runtime_registry_.get_allocator()));
+    runtime_registry_.template append_collection_bindings<collection_type>(
+        bindings, key);
+    if (bindings.empty()) {
+      if constexpr (can_resolve_collection_from_parent<collection_type,
+                                                       LookupKey>() &&
+                    detail::is_runtime_container_v<parent_container_type>) {
+        if (parent_) {
+          return parent_->template resolve_lazy<T>(std::move(key));
+        }
+      }
+      if (!registry_type::template has_explicit_collection_lookup<
+              collection_type>(key)) {
+        throw detail::make_collection_type_not_found_exception<
+            lazy_collection<T>, T>();
+      }
+    }
+    return lazy_collection<T>(
+        this, &resolve_lazy_element<T>,
+        detail::lazy_collection_bindings(std::move(bindings)));
+  }
+
+  template <typename T>
+  static T resolve_lazy_element(void *container, void *binding) {
+    auto &self = *static_cast<self_type *>(container);
+    auto &member =
+        *static_cast<typename registry_type::runtime_binding_interface_type *>(
+            binding);
+    [[maybe_unused]] auto lock = self.snapshot().lock();
+    return self.run_transaction([&](runtime_context_type &context) -> T {
+      return self.runtime_registry_.template resolve_collection_binding<T>(
+          ephemeral_scope, member, context);
+    });
+  }
+
+  template <typename T>
+  static T construct_parallel_member(void *container, void *context,
+                                     void *binding,
+                                     detail::parallel_member &member) {
+    auto &self = *static_cast<self_type *>(container);
+    detail::parallel_member_owner_scope owner(&self.snapshot());
+    inline_arena<DINGO_CONTEXT_ARENA_BUFFER_SIZE> scratch;
+    runtime_context_type local_context(
+        scratch, *static_cast<runtime_context_type *>(context), member);
+    auto &member_binding =
+        *static_cast<typename registry_type::runtime_binding_interface_type *>(
+            binding);
+    member.arm();
+    return self.runtime_registry_.template resolve_collection_binding<T>(
+        ephemeral_scope, member_binding, local_context);
+  }
+
+  // The hooks below are also reached from children, which hold only their
+  // own lock, so they take this container's.
+  template <typename R, typename LookupKey>
+  void check_stable_collection(const LookupKey &key) {
+    [[maybe_unused]] auto lock = snapshot().lock();
+    if (runtime_registry_.template count_collection<R>(key) != 0) {
+      runtime_registry_.template check_stable_collection<R>(key);
+      return;
+    }
+    if constexpr (can_resolve_collection_from_parent<R, LookupKey>() &&
+                  detail::is_runtime_container_v<parent_container_type>) {
+      if (parent_) {
+        parent_->template check_stable_collection<R>(key);
+      }
+    }
+  }
+
   self_type &runtime_registration_parent() { return *this; }
 
   template <typename Request, typename Key>
   detail::binding_status binding_status() {
+    [[maybe_unused]] auto lock = snapshot().lock();
     return runtime_registry_.template binding_status<Request>(Key{});
   }
 
   template <typename T, typename Key, typename Fn>
   std::size_t append_collection(T &results, construction_scope scope,
                                 runtime_context_type &context, Fn &&fn) {
+    [[maybe_unused]] auto lock = snapshot().lock();
     return runtime_registry_.template append_collection<T>(
         results, scope, context, std::forward<Fn>(fn), Key{});
   }
@@ -473,22 +1019,26 @@ private:
   std::size_t append_collection(T &results, construction_scope scope,
                                 runtime_context_type &context, Fn &&fn,
                                 LookupKey key) {
+    [[maybe_unused]] auto lock = snapshot().lock();
     return runtime_registry_.template append_collection<T>(
         results, scope, context, std::forward<Fn>(fn), std::move(key));
   }
 
   template <typename T, typename Key> std::size_t count_collection() {
+    [[maybe_unused]] auto lock = snapshot().lock();
     return runtime_registry_.template count_collection<T>(Key{});
   }
 
   template <typename T, typename LookupKey,
             std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
   std::size_t count_collection(LookupKey key) {
+    [[maybe_unused]] auto lock = snapshot().lock();
     return runtime_registry_.template count_collection<T>(std::move(key));
   }
 
   registry_type runtime_registry_;
   parent_container_type *parent_ = nullptr;
+  collection_cache_type *collections_ = nullptr;
 };
 
 } // namespace dingo
@@ -392,21 +392,16 @@ inline constexpr bool binding_has_direct_default_leaf_resolution_v = [] {
          std::is_same_v<request_leaf, stored_leaf>;
 }();
 
-template <typename Request>
-struct matching_binding_resolution<Request, type_list<>> {
-  using type = void;
-};
-
-template <typename Request, typename Head, typename... Tail>
-struct matching_binding_resolution<Request, type_list<Head, Tail...>> {
+template <typename Request, typename... Resolutions>
+struct matching_binding_resolution<Request, type_list<Resolutions...>> {
 private:
   using unwrapped_request = unwrapped_static_request_t<Request>;
 
 public:
-  using type = std::conditional_t<
-      is_resolution_request_v<typename Head::target_type, unwrapped_request>,
-      Head,
-      typename matching_binding_resolution<Request, type_list<Tail...>>::type>;
+  using type = type_list_at_t<
+      type_list_first_match<is_resolution_request_v<
+          typename Resolutions::target_type, unwrapped_request>...>(),
+      type_list<Resolutions...>>;
 };
 
 // Resolution target shapes are disjoint, so static lookup only needs to form
@@ -23,6 +23,13 @@ struct static_container_traits {
   using lookup_definition_type = std::tuple<>;
 };
 
+// Resolution strategies selected by `resolution_type` in static container
+// traits. `layered_resolution` leaves inlining to the optimizer;
+// `flattened_resolution` inlines the whole binding graph of a resolved type
+// into the public `resolve` and `construct` calls.
+struct layered_resolution {};
+struct flattened_resolution {};
+
 template <typename StaticSource, typename ParentContainer = void>
 class static_container;
 
@@ -67,6 +74,18 @@ struct static_container_traits<T,
 template <typename T>
 using static_container_traits_t = typename static_container_traits<T>::type;
 
+template <typename T, typename = void> struct container_resolution_type {
+  using type = layered_resolution;
+};
+
+template <typename T>
+struct container_resolution_type<T, std::void_t<typename T::resolution_type>> {
+  using type = typename T::resolution_type;
+};
+
+template <typename T>
+using container_resolution_type_t = typename container_resolution_type<T>::type;
+
 template <typename T> struct is_bindings_wrapper : std::false_type {};
 
 template <typename... Args>
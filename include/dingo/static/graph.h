@@ -19,6 +19,7 @@
 namespace dingo {
 
 struct shared;
+struct shared_concurrent;
 struct unique;
 struct shared_cyclical;
 
@@ -36,19 +37,11 @@ template <> struct filter_resolved_dependency_bindings<void> {
   using type = type_list<>;
 };
 
-template <> struct filter_resolved_dependency_bindings<type_list<>> {
-  using type = type_list<>;
-};
-
-template <typename Head, typename... Tail>
-struct filter_resolved_dependency_bindings<type_list<Head, Tail...>> {
-private:
-  using tail_type =
-      typename filter_resolved_dependency_bindings<type_list<Tail...>>::type;
-
-public:
-  using type = std::conditional_t<std::is_void_v<Head>, tail_type,
-                                  type_list_cat_t<type_list<Head>, tail_type>>;
+template <typename... DependencyBindings>
+struct filter_resolved_dependency_bindings<type_list<DependencyBindings...>> {
+  using type = type_list_cat_t<
+      std::conditional_t<std::is_void_v<DependencyBindings>, type_list<>,
+                         type_list<DependencyBindings>>...>;
 };
 
 template <typename DependencyBindings>
@@ -232,6 +225,8 @@ using dependency_graph_nodes_t =
 template <typename StorageTag> struct static_retains_frame : std::false_type {};
 
 template <> struct static_retains_frame<shared> : std::true_type {};
+template <>
+struct static_retains_frame<shared_concurrent> : std::true_type {};
 
 template <typename StorageTag>
 inline constexpr bool static_retains_frame_v =
@@ -864,15 +859,11 @@ struct static_graph_total_temporary_slots<type_list<Bindings...>>
 
 template <> struct static_dependency_bounds_known<void> : std::false_type {};
 
-template <>
-struct static_dependency_bounds_known<type_list<>> : std::true_type {};
-
-template <typename Head, typename... Tail>
-struct static_dependency_bounds_known<type_list<Head, Tail...>>
-    : std::bool_constant<
-          !collection_traits<
-              binding_dependency_interface_t<Head>>::is_collection &&
-          static_dependency_bounds_known<type_list<Tail...>>::value> {};
+template <typename... Dependencies>
+struct static_dependency_bounds_known<type_list<Dependencies...>>
+    : std::bool_constant<(!collection_traits<binding_dependency_interface_t<
+                              Dependencies>>::is_collection &&
+                          ...)> {};
 
 template <typename Binding>
 struct static_binding_dependency_bounds_known
@@ -0,0 +1,225 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/key.h>
+#include <dingo/type/type_list.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace dingo {
+namespace detail {
+
+// Runtime keys of static fixed-key bindings are mapped to binding positions
+// through a table computed at compile time: a direct table when the keys are
+// dense, otherwise a collision-free multiplicative hash. Either way a lookup
+// is one index computation and one key compare.
+template <typename Key>
+inline constexpr bool is_static_key_dispatch_key_v =
+    std::is_integral_v<Key> || std::is_enum_v<Key>;
+
+// Maps keys to unsigned integers preserving their order, so that dense ranges
+// of signed keys stay dense.
+template <typename Key> constexpr std::uint64_t static_key_bits(Key key) {
+  if constexpr (std::is_enum_v<Key>) {
+    return static_key_bits(static_cast<std::underlying_type_t<Key>>(key));
+  } else if constexpr (std::is_signed_v<Key>) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(key)) ^
+           (std::uint64_t{1} << 63);
+  } else {
+    return static_cast<std::uint64_t>(key);
+  }
+}
+
+enum class static_key_table_kind { dense, hashed, linear };
+
+struct static_key_layout {
+  static_key_table_kind kind = static_key_table_kind::linear;
+  std::uint64_t base = 0;
+  std::uint64_t multiplier = 0;
+  unsigned shift = 0;
+  std::size_t capacity = 0;
+};
+
+constexpr std::size_t static_key_dense_limit(std::size_t size) {
+  return size * 2 + 16;
+}
+
+constexpr std::size_t static_key_hash_slot(std::uint64_t bits,
+                                           const static_key_layout &layout) {
+  return static_cast<std::size_t>((bits * layout.multiplier) >> layout.shift);
+}
+
+template <std::size_t Size>
+constexpr bool
+static_key_hash_is_perfect(const std::array<std::uint64_t, Size> &bits,
+                           const static_key_layout &layout) {
+  for (std::size_t i = 0; i < Size; ++i) {
+    for (std::size_t j = 0; j < i; ++j) {
+      if (bits[i] != bits[j] && static_key_hash_slot(bits[i], layout) ==
+                                    static_key_hash_slot(bits[j], layout)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <std::size_t Size>
+constexpr static_key_layout
+make_static_key_layout(const std::array<std::uint64_t, Size> &bits) {
+  static_key_layout layout;
+  if constexpr (Size != 0) {
+    std::uint64_t min = bits[0];
+    std::uint64_t max = bits[0];
+    for (auto value : bits) {
+      min = value < min ? value : min;
+      max = value > max ? value : max;
+    }
+    if (max - min < static_key_dense_limit(Size)) {
+      layout.kind = static_key_table_kind::dense;
+      layout.base = min;
+      layout.capacity = static_cast<std::size_t>(max - min) + 1;
+      return layout;
+    }
+
+    unsigned bits_count = 1;
+    while ((std::size_t{1} << bits_count) < Size) {
+      ++bits_count;
+    }
+    for (unsigned extra = 0; extra < 4; ++extra, ++bits_count) {
+      for (std::uint64_t attempt = 0; attempt < 256; ++attempt) {
+        layout.kind = static_key_table_kind::hashed;
+        layout.multiplier = (0x9E3779B97F4A7C15ull * (2 * attempt + 1)) | 1;
+        layout.shift = 64 - bits_count;
+        layout.capacity = std::size_t{1} << bits_count;
+        if (static_key_hash_is_perfect(bits, layout)) {
+          return layout;
+        }
+      }
+    }
+  }
+  layout = static_key_layout{};
+  layout.capacity = Size;
+  return layout;
+}
+
+template <typename Key, typename LookupKeys> struct static_key_index;
+
+template <typename Key, typename... LookupKeys>
+struct static_key_index<Key, type_list<LookupKeys...>> {
+  static constexpr std::size_t size = sizeof...(LookupKeys);
+
+private:
+  static constexpr std::array<std::uint64_t, size> bits = {
+      static_key_bits<Key>(LookupKeys{}.backend_key())...};
+
+public:
+  static constexpr static_key_layout layout = make_static_key_layout(bits);
+
+private:
+  struct slot {
+    std::uint64_t bits = 0;
+    std::size_t position = size;
+  };
+
+  static constexpr std::size_t slot_position(std::uint64_t value) {
+    if constexpr (layout.kind == static_key_table_kind::dense) {
+      return static_cast<std::size_t>(value - layout.base);
+    } else if constexpr (layout.kind == static_key_table_kind::hashed) {
+      return static_key_hash_slot(value, layout);
+    } else {
+      return 0;
+    }
+  }
+
+  // Slots keep the first binding position of each key; later bindings with
+  // the same key value share the slot.
+  static constexpr std::array<slot, layout.capacity> make_slots() {
+    std::array<slot, layout.capacity> result{};
+    for (std::size_t i = 0; i < size; ++i) {
+      if constexpr (layout.kind == static_key_table_kind::linear) {
+        result[i] = slot{bits[i], i};
+      } else {
+        auto &entry = result[slot_position(bits[i])];
+        if (entry.position == size) {
+          entry = slot{bits[i], i};
+        }
+      }
+    }
+    return result;
+  }
+
+  static constexpr std::array<slot, layout.capacity> slots = make_slots();
+
+public:
+  // Returns the position of the first binding with the key, or size.
+  static std::size_t find(Key key) {
+    if constexpr (size == 0) {
+      (void)key;
+      return size;
+    } else {
+      const auto value = static_key_bits(key);
+      if constexpr (layout.kind == static_key_table_kind::linear) {
+        for (const auto &entry : slots) {
+          if (entry.bits == value) {
+            return entry.position;
+          }
+        }
+        return size;
+      } else {
+        const auto position = slot_position(value);
+        if constexpr (layout.kind == static_key_table_kind::dense) {
+          if (position >= layout.capacity) {
+            return size;
+          }
+        }
+        const auto &entry = slots[position];
+        return entry.bits == value ? entry.position : size;
+      }
+    }
+  }
+};
+
+template <typename Interface, typename Key, typename InterfaceBinding,
+          typename LookupKey = typename InterfaceBinding::key_type>
+struct static_key_dispatch_binding {
+  using type = type_list<>;
+};
+
+template <typename Interface, typename Key, typename InterfaceBinding,
+          auto Value>
+struct static_key_dispatch_binding<
+    Interface, Key, InterfaceBinding,
+    lookup_key<::dingo::key_type<Key, Value>>> {
+  using type = std::conditional_t<
+      std::is_same_v<Interface, typename InterfaceBinding::interface_type>,
+      type_list<lookup_key<::dingo::key_type<Key, Value>>>, type_list<>>;
+};
+
+// Fixed lookup keys of the bindings that `Interface` can be resolved from by a
+// runtime key of type `Key`, in binding order.
+template <typename Interface, typename Key, typename InterfaceBindings>
+struct static_key_dispatch_keys;
+
+template <typename Interface, typename Key, typename... InterfaceBindings>
+struct static_key_dispatch_keys<Interface, Key,
+                                type_list<InterfaceBindings...>> {
+  using type = type_list_cat_t<typename static_key_dispatch_binding<
+      Interface, Key, InterfaceBindings>::type...>;
+};
+
+template <typename Interface, typename Key, typename InterfaceBindings>
+using static_key_dispatch_keys_t =
+    typename static_key_dispatch_keys<Interface, Key, InterfaceBindings>::type;
+
+} // namespace detail
+} // namespace dingo
@@ -101,34 +101,16 @@ struct binding_matches
                             typename InterfaceBinding::key_type>::value> {};
 
 template <typename Interface, typename LookupKey, typename InterfaceBindings>
-struct bindings;
+struct matching_bindings;
 
 template <typename Interface, typename LookupKey, typename... InterfaceBindings>
-struct bindings<Interface, LookupKey, type_list<InterfaceBindings...>> {
+struct matching_bindings<Interface, LookupKey,
+                         type_list<InterfaceBindings...>> {
   using type = type_list_cat_t<std::conditional_t<
       binding_matches<Interface, LookupKey, InterfaceBindings>::value,
       type_list<InterfaceBindings>, type_list<>>...>;
 };
 
-template <typename Interface, typename LookupKey, typename InterfaceBindings>
-using bindings_t =
-    typename bindings<Interface, LookupKey, InterfaceBindings>::type;
-
-template <typename Interface, typename LookupKey, typename InterfaceBindings>
-struct binding_count;
-
-template <typename Interface, typename LookupKey, typename... InterfaceBindings>
-struct binding_count<Interface, LookupKey, type_list<InterfaceBindings...>>
-    : std::integral_constant<size_t, (size_t{0} + ... +
-                                      (binding_matches<Interface, LookupKey,
-                                                       InterfaceBindings>::value
-                                           ? size_t{1}
-                                           : size_t{0}))> {};
-
-template <typename Interface, typename LookupKey, typename InterfaceBindings>
-inline constexpr size_t binding_count_v =
-    binding_count<Interface, LookupKey, InterfaceBindings>::value;
-
 template <typename Interface, typename LookupKey> struct binding_lookup_tag {};
 
 template <size_t Index, typename InterfaceBinding>
@@ -146,6 +128,9 @@ struct binding_lookup_index_impl<type_list<InterfaceBindings...>,
                                  std::index_sequence<Indexes...>>
     : binding_lookup_index_entry<Indexes, InterfaceBindings>... {
   using binding_lookup_index_entry<Indexes, InterfaceBindings>::select...;
+
+  // Chosen only when no binding is registered for the tag.
+  static void select(...);
 };
 
 template <typename InterfaceBindings>
@@ -153,28 +138,92 @@ using binding_lookup_index = binding_lookup_index_impl<
     InterfaceBindings,
     std::make_index_sequence<type_list_size_v<InterfaceBindings>>>;
 
+template <typename Selected> struct indexed_binding_choice {
+  using type = found_binding_choice_t<typename Selected::type>;
+};
+
+template <> struct indexed_binding_choice<void> {
+  using type = missing_binding_choice_t;
+};
+
+// Selection by the overload set of the index costs one overload resolution
+// per request instead of an instantiation per registered binding. Two bindings
+// for the same tag make the call ambiguous, which selects the primary
+// template.
 template <typename Interface, typename LookupKey, typename InterfaceBindings,
-          size_t Count =
-              binding_count_v<Interface, LookupKey, InterfaceBindings>>
+          typename = void>
 struct indexed_binding_selection {
   using type = ambiguous_binding_choice_t;
 };
 
 template <typename Interface, typename LookupKey, typename InterfaceBindings>
-struct indexed_binding_selection<Interface, LookupKey, InterfaceBindings, 0> {
-  using type = missing_binding_choice_t;
+struct indexed_binding_selection<
+    Interface, LookupKey, InterfaceBindings,
+    std::void_t<decltype(binding_lookup_index<InterfaceBindings>::select(
+        binding_lookup_tag<Interface, LookupKey>{}))>> {
+  using type = typename indexed_binding_choice<
+      decltype(binding_lookup_index<InterfaceBindings>::select(
+          binding_lookup_tag<Interface, LookupKey>{}))>::type;
 };
 
-template <typename Interface, typename LookupKey, typename InterfaceBindings>
-struct indexed_binding_selection<Interface, LookupKey, InterfaceBindings, 1> {
-private:
-  using selected = decltype(binding_lookup_index<InterfaceBindings>::select(
-      binding_lookup_tag<Interface, LookupKey>{}));
+template <typename Choice, typename Interface, typename LookupKey,
+          typename InterfaceBindings>
+struct indexed_bindings {
+  using type = typename matching_bindings<Interface, LookupKey,
+                                          InterfaceBindings>::type;
+};
 
-public:
-  using type = found_binding_choice_t<typename selected::type>;
+template <typename Binding, typename Interface, typename LookupKey,
+          typename InterfaceBindings>
+struct indexed_bindings<found_binding_choice_t<Binding>, Interface, LookupKey,
+                        InterfaceBindings> {
+  using type = type_list<Binding>;
 };
 
+template <typename Interface, typename LookupKey, typename InterfaceBindings>
+struct indexed_bindings<missing_binding_choice_t, Interface, LookupKey,
+                        InterfaceBindings> {
+  using type = type_list<>;
+};
+
+// Keyless lookups take their bindings from the index and scan the registered
+// bindings only for interfaces bound more than once.
+template <typename Interface, typename LookupKey, typename InterfaceBindings,
+          bool UseIndex = is_no_lookup_key_v<LookupKey>>
+struct bindings
+    : matching_bindings<Interface, LookupKey, InterfaceBindings> {};
+
+template <typename Interface, typename LookupKey, typename InterfaceBindings>
+struct bindings<Interface, LookupKey, InterfaceBindings, true>
+    : indexed_bindings<typename indexed_binding_selection<
+                           Interface, LookupKey, InterfaceBindings>::type,
+                       Interface, LookupKey, InterfaceBindings> {};
+
+template <typename Interface, typename LookupKey, typename InterfaceBindings>
+using bindings_t =
+    typename bindings<Interface, LookupKey, InterfaceBindings>::type;
+
+template <typename Interface, typename LookupKey, typename InterfaceBindings,
+          bool UseIndex = is_no_lookup_key_v<LookupKey>>
+struct binding_count;
+
+template <typename Interface, typename LookupKey, typename... InterfaceBindings>
+struct binding_count<Interface, LookupKey, type_list<InterfaceBindings...>,
+                     false>
+    : std::integral_constant<size_t, (size_t{0} + ... +
+                                      (binding_matches<Interface, LookupKey,
+                                                       InterfaceBindings>::value
+                                           ? size_t{1}
+                                           : size_t{0}))> {};
+
+template <typename Interface, typename LookupKey, typename InterfaceBindings>
+struct binding_count<Interface, LookupKey, InterfaceBindings, true>
+    : type_list_size<bindings_t<Interface, LookupKey, InterfaceBindings>> {};
+
+template <typename Interface, typename LookupKey, typename InterfaceBindings>
+inline constexpr size_t binding_count_v =
+    binding_count<Interface, LookupKey, InterfaceBindings>::value;
+
 template <typename Interface, typename LookupKey, typename InterfaceBindings,
           bool UseIndex = is_no_lookup_key_v<LookupKey>>
 struct binding_selection {
@@ -352,18 +401,13 @@ struct first_missing_declared_dependency<type_list<>, InterfaceBindings> {
   using type = void;
 };
 
-template <typename Head, typename... Tail, typename InterfaceBindings>
-struct first_missing_declared_dependency<type_list<Head, Tail...>,
+template <typename... Dependencies, typename InterfaceBindings>
+struct first_missing_declared_dependency<type_list<Dependencies...>,
                                          InterfaceBindings> {
-private:
-  using dependency_type = binding_dependency_interface_t<Head>;
-  using dependency_key = binding_dependency_key_t<Head>;
-
-public:
-  using type = std::conditional_t<
-      !declared_dependency_is_registered<Head, InterfaceBindings>::value, Head,
-      typename first_missing_declared_dependency<type_list<Tail...>,
-                                                 InterfaceBindings>::type>;
+  using type = type_list_at_t<
+      type_list_first_match<!declared_dependency_is_registered<
+          Dependencies, InterfaceBindings>::value...>(),
+      type_list<Dependencies...>>;
 };
 
 template <typename DependencyList, typename InterfaceBindings>
@@ -374,16 +418,12 @@ using first_missing_declared_dependency_t =
 template <typename InterfaceBindings>
 struct dependencies_registered<void, InterfaceBindings> : std::false_type {};
 
-template <typename InterfaceBindings>
-struct dependencies_registered<type_list<>, InterfaceBindings>
-    : std::true_type {};
-
-template <typename Head, typename... Tail, typename InterfaceBindings>
-struct dependencies_registered<type_list<Head, Tail...>, InterfaceBindings>
-    : std::bool_constant<
-          declared_dependency_is_registered<Head, InterfaceBindings>::value &&
-          dependencies_registered<type_list<Tail...>,
-                                  InterfaceBindings>::value> {};
+template <typename... Dependencies, typename InterfaceBindings>
+struct dependencies_registered<type_list<Dependencies...>, InterfaceBindings>
+    : std::bool_constant<(
+          declared_dependency_is_registered<Dependencies,
+                                            InterfaceBindings>::value &&
+          ...)> {};
 
 template <typename InterfaceBindings>
 struct dependency_bindings<void, InterfaceBindings> {
@@ -435,14 +475,9 @@ struct dependency_bindings_are_resolved : std::false_type {};
 
 template <> struct dependency_bindings_are_resolved<void> : std::false_type {};
 
-template <>
-struct dependency_bindings_are_resolved<type_list<>> : std::true_type {};
-
-template <typename Head, typename... Tail>
-struct dependency_bindings_are_resolved<type_list<Head, Tail...>>
-    : std::bool_constant<
-          !std::is_void_v<Head> &&
-          dependency_bindings_are_resolved<type_list<Tail...>>::value> {};
+template <typename... Bindings>
+struct dependency_bindings_are_resolved<type_list<Bindings...>>
+    : std::bool_constant<(!std::is_void_v<Bindings> && ...)> {};
 
 template <typename BindingModel, typename InterfaceBindings,
           typename LocalBindings = typename BindingModel::bindings_type>
@@ -451,39 +486,28 @@ struct effective_interface_bindings {
 };
 
 template <typename InterfaceBinding, typename InterfaceBindings>
-struct binding_shadowed_by {
-  static constexpr bool value = false;
-};
+struct binding_shadowed_by;
 
-template <typename InterfaceBinding, typename Head, typename... Tail>
-struct binding_shadowed_by<InterfaceBinding, type_list<Head, Tail...>>
-    : std::bool_constant<
+template <typename InterfaceBinding, typename... LocalInterfaceBindings>
+struct binding_shadowed_by<InterfaceBinding,
+                           type_list<LocalInterfaceBindings...>>
+    : std::bool_constant<(
           (std::is_same_v<typename InterfaceBinding::interface_type,
-                          typename Head::interface_type> &&
-           lookup_keys_match<typename InterfaceBinding::key_type,
-                             typename Head::key_type>::value) ||
-          binding_shadowed_by<InterfaceBinding, type_list<Tail...>>::value> {};
+                          typename LocalInterfaceBindings::interface_type> &&
+           lookup_keys_match<
+               typename InterfaceBinding::key_type,
+               typename LocalInterfaceBindings::key_type>::value) ||
+          ...)> {};
 
 template <typename InterfaceBindings, typename LocalInterfaceBindings>
 struct remove_shadowed_bindings;
 
-template <typename LocalInterfaceBindings>
-struct remove_shadowed_bindings<type_list<>, LocalInterfaceBindings> {
-  using type = type_list<>;
-};
-
-template <typename Head, typename... Tail, typename LocalInterfaceBindings>
-struct remove_shadowed_bindings<type_list<Head, Tail...>,
+template <typename... InterfaceBindings, typename LocalInterfaceBindings>
+struct remove_shadowed_bindings<type_list<InterfaceBindings...>,
                                 LocalInterfaceBindings> {
-private:
-  using tail_type =
-      typename remove_shadowed_bindings<type_list<Tail...>,
-                                        LocalInterfaceBindings>::type;
-
-public:
-  using type = std::conditional_t<
-      binding_shadowed_by<Head, LocalInterfaceBindings>::value, tail_type,
-      type_list_cat_t<type_list<Head>, tail_type>>;
+  using type = type_list_cat_t<std::conditional_t<
+      binding_shadowed_by<InterfaceBindings, LocalInterfaceBindings>::value,
+      type_list<>, type_list<InterfaceBindings>>...>;
 };
 
 template <typename BindingModel, typename InterfaceBindings,
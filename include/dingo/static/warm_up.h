@@ -0,0 +1,225 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/warm_up.h>
+#include <dingo/registration/type_registration.h>
+#include <dingo/static/activation_set.h>
+#include <dingo/static/graph.h>
+#include <dingo/type/type_list.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace dingo::detail {
+
+template <std::size_t... Values> constexpr std::size_t static_max_v() {
+  std::size_t result = 0;
+  ((result = std::max(result, Values)), ...);
+  return result;
+}
+
+template <typename Binding, typename StaticBindings>
+using static_warm_up_dependencies_t =
+    typename static_graph_node_t<Binding, StaticBindings,
+                                 false>::dependency_bindings;
+
+// Bindings whose factory detects its constructor have no dependency list in
+// the static graph. They may construct any binding while they run, so they
+// are never handed to the executor.
+template <typename Binding, typename StaticBindings>
+inline constexpr bool static_warm_up_opaque_v =
+    std::is_void_v<static_warm_up_dependencies_t<Binding, StaticBindings>>;
+
+// Layer of a binding in the static graph: bindings without dependencies are
+// in layer zero and every other binding is one layer above its deepest
+// dependency. A dependency cycle (only legal through shared_cyclical storage)
+// is cut where it closes.
+template <typename Binding, typename StaticBindings, typename Visiting,
+          bool InVisiting = type_list_contains_v<Binding, Visiting>>
+struct static_warm_up_layer;
+
+template <typename Dependencies, typename StaticBindings, typename Visiting>
+struct static_warm_up_dependencies_layer
+    : std::integral_constant<std::size_t, 0> {};
+
+template <typename... Dependencies, typename StaticBindings, typename Visiting>
+struct static_warm_up_dependencies_layer<type_list<Dependencies...>,
+                                         StaticBindings, Visiting>
+    : std::integral_constant<
+          std::size_t,
+          static_max_v<(static_warm_up_layer<Dependencies, StaticBindings,
+                                             Visiting>::value +
+                        1)...>()> {};
+
+template <typename Binding, typename StaticBindings, typename Visiting>
+struct static_warm_up_layer<Binding, StaticBindings, Visiting, true>
+    : std::integral_constant<std::size_t, 0> {};
+
+template <typename Binding, typename StaticBindings, typename Visiting>
+struct static_warm_up_layer<Binding, StaticBindings, Visiting, false>
+    : static_warm_up_dependencies_layer<
+          static_warm_up_dependencies_t<Binding, StaticBindings>,
+          StaticBindings, type_list_cat_t<Visiting, type_list<Binding>>> {};
+
+template <typename Binding, typename StaticBindings>
+inline constexpr std::size_t static_warm_up_layer_v =
+    static_warm_up_layer<Binding, StaticBindings, type_list<>>::value;
+
+// Like static_binding_resolvable_v, but accepts opaque bindings: whether
+// their detected constructor resolves is checked when it is instantiated.
+template <typename Binding, typename StaticBindings,
+          typename Visiting = type_list<>,
+          bool InVisiting = type_list_contains_v<Binding, Visiting>>
+struct static_warm_up_resolvable;
+
+template <typename Dependencies, typename StaticBindings, typename Visiting>
+struct static_warm_up_dependencies_resolvable : std::true_type {};
+
+template <typename... Dependencies, typename StaticBindings, typename Visiting>
+struct static_warm_up_dependencies_resolvable<type_list<Dependencies...>,
+                                              StaticBindings, Visiting>
+    : std::bool_constant<(static_warm_up_resolvable<Dependencies,
+                                                    StaticBindings,
+                                                    Visiting>::value &&
+                          ...)> {};
+
+template <typename StaticBindings, typename Visiting>
+struct static_warm_up_resolvable<void, StaticBindings, Visiting, false>
+    : std::false_type {};
+
+template <typename Binding, typename StaticBindings, typename Visiting>
+struct static_warm_up_resolvable<Binding, StaticBindings, Visiting, true>
+    : std::bool_constant<
+          static_cycle_uses_cyclical_storage_v<Binding, Visiting>> {};
+
+template <typename Binding, typename StaticBindings, typename Visiting>
+struct static_warm_up_resolvable<Binding, StaticBindings, Visiting, false>
+    : static_warm_up_dependencies_resolvable<
+          static_warm_up_dependencies_t<Binding, StaticBindings>,
+          StaticBindings, type_list_cat_t<Visiting, type_list<Binding>>> {};
+
+template <typename Binding, typename StaticRegistry>
+inline constexpr bool static_warm_up_binding_v = [] {
+  using key_type = typename Binding::key_type;
+  using request = request_type<typename Binding::interface_type &>;
+  using tag_type = typename Binding::storage_type::tag_type;
+  using bindings_type = typename StaticRegistry::static_bindings_type;
+  if constexpr (is_warm_up_storage_v<tag_type> &&
+                std::is_default_constructible_v<key_type>) {
+    return StaticRegistry::template binding_status<
+               typename request::lookup_type, key_type>() ==
+               binding_status::found &&
+           binding_supports_request_v<typename request::interface_type,
+                                      Binding> &&
+           static_warm_up_resolvable<Binding, bindings_type>::value;
+  } else {
+    return false;
+  }
+}();
+
+// Bindings constructed on the calling thread rather than by the executor.
+template <typename Binding, typename StaticBindings>
+inline constexpr bool static_warm_up_inline_v =
+    !(std::is_same_v<typename Binding::storage_type::tag_type, shared> ||
+      std::is_same_v<typename Binding::storage_type::tag_type,
+                     shared_concurrent>) ||
+    static_warm_up_opaque_v<Binding, StaticBindings>;
+
+// Bindings warmed by static_container::warm_up(): one per shared binding
+// model, so no two tasks ever construct the same storage. A binding is kept
+// when it is the first warmable binding of its model.
+template <typename StaticRegistry, typename Bindings>
+struct static_warm_up_bindings;
+
+template <typename StaticRegistry, typename... Bindings>
+struct static_warm_up_bindings<StaticRegistry, type_list<Bindings...>> {
+private:
+  using warmable = type_list_cat_t<
+      std::conditional_t<static_warm_up_binding_v<Bindings, StaticRegistry>,
+                         type_list<Bindings>, type_list<>>...>;
+
+  using models = type_list_cat_t<std::conditional_t<
+      static_warm_up_binding_v<Bindings, StaticRegistry>,
+      type_list<typename Bindings::binding_model_type>, type_list<>>...>;
+
+public:
+  using type = type_list_first_occurrence_filter_t<models, warmable>;
+};
+
+template <typename StaticRegistry>
+using static_warm_up_bindings_t = typename static_warm_up_bindings<
+    StaticRegistry, typename StaticRegistry::interface_bindings>::type;
+
+template <typename Bindings, typename StaticBindings>
+struct static_warm_up_layers;
+
+template <typename... Bindings, typename StaticBindings>
+struct static_warm_up_layers<type_list<Bindings...>, StaticBindings>
+    : std::integral_constant<
+          std::size_t,
+          static_max_v<(static_warm_up_layer_v<Bindings, StaticBindings> +
+                        1)...>()> {};
+
+// Counts the tasks of one warm-up layer and keeps the first failure.
+class static_warm_up_latch {
+public:
+  void add() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_;
+  }
+
+  template <typename Fn> void run(Fn &&fn) noexcept {
+    std::exception_ptr error;
+    try {
+      fn();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    finish(std::move(error));
+  }
+
+  void finish(std::exception_ptr error) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error && !error_) {
+      error_ = std::move(error);
+    }
+    if (--pending_ == 0) {
+      done_.notify_all();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    if (error_) {
+      std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+  }
+
+  // Waits for the pending tasks when the layer is abandoned by an exception
+  // of its own; their failures are dropped.
+  void drain() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    error_ = nullptr;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  std::size_t pending_ = 0;
+  std::exception_ptr error_;
+};
+
+} // namespace dingo::detail
@@ -12,9 +12,15 @@
 #include <dingo/static/activation_set.h>
 #include <dingo/static/container_traits.h>
 #include <dingo/static/context.h>
+#include <dingo/static/key_dispatch.h>
 #include <dingo/static/resolution.h>
+#include <dingo/static/warm_up.h>
 #include <dingo/type/dependency_traits.h>
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -99,6 +105,9 @@ public:
 
 private:
   static constexpr bool has_parent_v = !std::is_void_v<ParentContainer>;
+  static constexpr bool flattens_resolution_v =
+      std::is_same_v<container_resolution_type_t<ContainerTraits>,
+                     flattened_resolution>;
   using graph_type_ = std::conditional_t<
       has_parent_v, graph_analysis<static_bindings_type, true>,
       typename static_container_graph_type<
@@ -273,42 +282,14 @@ public:
 
   template <typename T, typename LookupKey,
             typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0,
             typename = typename resolve_request_check<request_type<T, false>, R,
-                                                      LookupKey>::type,
-            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+                                                      LookupKey>::type>
   R resolve(LookupKey key) {
-    using lookup_request = request_type<T, true>;
-    using request = request_type<T, false>;
-    if constexpr (!collection_traits<R>::is_collection) {
-      if constexpr (uses_static_minimal_context_v<request, R, LookupKey>) {
-        using selected = typename static_registry_type::template selection<
-            typename lookup_request::lookup_type, LookupKey>;
-        static_resolution_context_t<request, R, LookupKey> context;
-        return static_registry_.template resolve_binding<
-            typename lookup_request::lookup_type, R, selected>(ephemeral_scope,
-                                                               context, *this);
-      }
-    }
-    if constexpr (collection_traits<R>::is_collection) {
-      if constexpr (has_parent_v && collection_count_v<R, LookupKey> == 0) {
-        context_type context;
-        return resolve_request<request, R>(ephemeral_scope, context, *this,
-                                           key);
-      } else {
-        context_type context;
-        return resolve_request<request, R>(ephemeral_scope, context, *this,
-                                           key);
-      }
+    if constexpr (flattens_resolution_v) {
+      return resolve_flattened<T, LookupKey, R>(std::move(key));
     } else {
-      if constexpr (has_parent_v && resolve_status_v<request, LookupKey> ==
-                                        binding_status::not_found) {
-        if (parent_) {
-          context_type context;
-          return resolve_parent<request>(ephemeral_scope, context, *this, key);
-        }
-      }
-      context_type context;
-      return resolve_request<request, R>(ephemeral_scope, context, *this, key);
+      return resolve_layered<T, LookupKey, R>(std::move(key));
     }
   }
 
@@ -382,6 +363,8 @@ public:
     using lookup_key_type = decltype(key);
     if constexpr (detail::is_static_lookup_key_v<lookup_key_type>) {
       return resolve<T, lookup_key_type, R>(std::move(key));
+    } else if constexpr (uses_static_key_dispatch_v<T, R, lookup_key_type>) {
+      return resolve_runtime_key<T, R>(key);
     } else {
       static_assert(detail::container_dependent_false_v<T, lookup_key_type>,
                     "static_container fixed runtime-key request requires "
@@ -389,13 +372,235 @@ public:
     }
   }
 
+  // Resolves all requests in order. Static resolution has no transaction to
+  // share; this mirrors the runtime containers' batched API.
+  template <typename... Ts>
+  std::tuple<typename request_type<Ts, true>::result_type...> resolve_all() {
+    using result_type =
+        std::tuple<typename request_type<Ts, true>::result_type...>;
+    return result_type{resolve<Ts>()...};
+  }
+
+  // Resolves `T` once and returns a handle to its address. The selected
+  // binding must keep a stable address; this is checked at compile time.
+  template <typename T, typename Key = key_type<none_t>,
+            typename R = typename request_type<T, true>::result_type>
+  binding_handle<R> handle() {
+    return handle<T>(detail::make_lookup_key(type_selector<Key>{}));
+  }
+
+  template <typename T, typename LookupKey,
+            typename R = typename request_type<T, true>::result_type,
+            std::enable_if_t<detail::is_lookup_key_v<LookupKey>, int> = 0>
+  binding_handle<R> handle(LookupKey key) {
+    using request = request_type<T, true>;
+    static_assert(detail::cache::supports_v<R> &&
+                      !collection_traits<R>::is_collection,
+                  "binding handle requires a reference or pointer request");
+    if constexpr (resolve_status_v<request, LookupKey> ==
+                  binding_status::found) {
+      using binding = typename selection_t<typename request::lookup_type,
+                                           LookupKey>::binding_type;
+      static_assert(detail::static_binding_is_stable_v<binding>,
+                    "binding handle requires stable storage");
+    } else if constexpr (has_parent_v) {
+      if (parent_) {
+        return parent_->template handle<T>(std::move(key));
+      }
+    }
+    return binding_handle<R>(resolve<T>(std::move(key)));
+  }
+
+  // Materializes the shared bindings of this container one graph layer at a
+  // time. Every `scope<shared>` binding of a layer is handed to `executor`
+  // as a `std::function<void()>` task, so independent subgraphs can be
+  // constructed concurrently; a layer starts once the previous one finished.
+  // shared_cyclical bindings and bindings with detected constructors, whose
+  // dependencies are not known to the graph, are constructed on the calling
+  // thread before the tasks of their layer are submitted. The first
+  // exception thrown by a task is rethrown once its layer completes.
+  template <typename Executor> warm_up_report warm_up(Executor &&executor) {
+    using bindings = detail::static_warm_up_bindings_t<static_registry_type>;
+    constexpr std::size_t layers =
+        detail::static_warm_up_layers<bindings, static_bindings_type>::value;
+
+    warm_up_report report(type_list_size_v<bindings>);
+    std::size_t slot = 0;
+    detail::static_warm_up_latch latch;
+    for (std::size_t layer = 0; layer < layers; ++layer) {
+      for_each(bindings{}, [&](auto element) {
+        using binding = typename decltype(element)::type;
+        if constexpr (detail::static_warm_up_inline_v<binding,
+                                                      static_bindings_type>) {
+          if (detail::static_warm_up_layer_v<binding, static_bindings_type> ==
+              layer) {
+            warm_up_binding<binding>(report[slot++]);
+          }
+        }
+      });
+      try {
+        for_each(bindings{}, [&](auto element) {
+          using binding = typename decltype(element)::type;
+          if constexpr (!detail::static_warm_up_inline_v<
+                            binding, static_bindings_type>) {
+            if (detail::static_warm_up_layer_v<binding,
+                                               static_bindings_type> !=
+                layer) {
+              return;
+            }
+            auto &entry = report[slot++];
+            latch.add();
+            try {
+              executor(std::function<void()>([this, &entry, &latch] {
+                latch.run([&] { warm_up_binding<binding>(entry); });
+              }));
+            } catch (...) {
+              latch.finish(nullptr);
+              throw;
+            }
+          }
+        });
+      } catch (...) {
+        latch.drain();
+        throw;
+      }
+      latch.wait();
+    }
+    return report;
+  }
+
+  // Materializes the shared bindings on the calling thread.
+  warm_up_report warm_up() {
+    return warm_up([](const std::function<void()> &task) { task(); });
+  }
+
   template <typename T, typename Factory = constructor<normalized_type_t<T>>,
             typename R = typename request_type<T, true>::result_type>
   R construct(Factory factory = Factory()) {
-    return construct_request<request_type<T>, Factory, R>(std::move(factory));
+    if constexpr (flattens_resolution_v) {
+      return construct_flattened<request_type<T>, Factory, R>(
+          std::move(factory));
+    } else {
+      return construct_request<request_type<T>, Factory, R>(std::move(factory));
+    }
   }
 
 private:
+  template <typename T, typename LookupKey, typename R>
+  R resolve_layered(LookupKey key) {
+    using lookup_request = request_type<T, true>;
+    using request = request_type<T, false>;
+    if constexpr (!collection_traits<R>::is_collection) {
+      if constexpr (uses_static_minimal_context_v<request, R, LookupKey>) {
+        using selected = typename static_registry_type::template selection<
+            typename lookup_request::lookup_type, LookupKey>;
+        static_resolution_context_t<request, R, LookupKey> context;
+        return static_registry_.template resolve_binding<
+            typename lookup_request::lookup_type, R, selected>(ephemeral_scope,
+                                                               context, *this);
+      }
+    }
+    if constexpr (collection_traits<R>::is_collection) {
+      if constexpr (has_parent_v && collection_count_v<R, LookupKey> == 0) {
+        context_type context;
+        return resolve_request<request, R>(ephemeral_scope, context, *this,
+                                           key);
+      } else {
+        context_type context;
+        return resolve_request<request, R>(ephemeral_scope, context, *this,
+                                           key);
+      }
+    } else {
+      if constexpr (has_parent_v && resolve_status_v<request, LookupKey> ==
+                                        binding_status::not_found) {
+        if (parent_) {
+          context_type context;
+          return resolve_parent<request>(ephemeral_scope, context, *this, key);
+        }
+      }
+      context_type context;
+      return resolve_request<request, R>(ephemeral_scope, context, *this, key);
+    }
+  }
+
+  // Inlines the layers of the static resolution below the call into one body.
+  template <typename T, typename LookupKey, typename R>
+  DINGO_FLATTEN R resolve_flattened(LookupKey key) {
+    return resolve_layered<T, LookupKey, R>(std::move(key));
+  }
+
+  template <typename Request, typename Factory, typename R>
+  DINGO_FLATTEN R construct_flattened(Factory factory) {
+    return construct_request<Request, Factory, R>(std::move(factory));
+  }
+
+  template <typename Binding> void warm_up_binding(warm_up_entry &entry) {
+    using interface_type = typename Binding::interface_type;
+    const auto start = std::chrono::steady_clock::now();
+    (void)resolve<interface_type &>(typename Binding::key_type{});
+    const auto finish = std::chrono::steady_clock::now();
+    entry = {describe_type<normalized_type_t<interface_type>>(),
+             std::chrono::duration_cast<std::chrono::nanoseconds>(finish -
+                                                                  start)};
+  }
+
+  // Singular requests by an integral or enum runtime key are dispatched over
+  // the fixed keys of the declared associative lookup without touching a
+  // runtime backend.
+  template <typename T, typename R, typename LookupKey>
+  static constexpr bool uses_static_key_dispatch_v = [] {
+    using key_type_ = typename LookupKey::backend_key_type;
+    if constexpr (collection_traits<R>::is_collection ||
+                  !detail::is_static_key_dispatch_key_v<key_type_>) {
+      return false;
+    } else {
+      return !std::is_void_v<detail::selected_lookup_entry_t<
+          typename request_type<T, false>::lookup_type,
+          detail::lookup_key<key_value<key_type_>>, index_entries_>>;
+    }
+  }();
+
+  template <typename T, typename R, typename LookupKey>
+  R resolve_runtime_key(const LookupKey &key) {
+    using request = request_type<T, false>;
+    using key_type_ = typename LookupKey::backend_key_type;
+    using lookup_keys = detail::static_key_dispatch_keys_t<
+        detail::binding_dependency_interface_t<typename request::lookup_type>,
+        key_type_,
+        typename static_bindings_type::interface_bindings>;
+    using index = detail::static_key_index<key_type_, lookup_keys>;
+
+    const auto position = index::find(key.backend_key());
+    if (position != index::size) {
+      return resolve_runtime_key_at<T, R>(position, lookup_keys{});
+    }
+    if constexpr (has_parent_v) {
+      if (parent_) {
+        return parent_->template resolve<T>(key.backend_key());
+      }
+    }
+    throw make_type_not_found_exception<typename request::lookup_type>();
+  }
+
+  template <typename T, typename R, typename... LookupKeys>
+  R resolve_runtime_key_at(std::size_t position, type_list<LookupKeys...>) {
+    using resolve_fn = R (*)(self_type &);
+    static constexpr resolve_fn table[] = {
+        &resolve_fixed_key<T, R, LookupKeys>...};
+    return table[position](*this);
+  }
+
+  template <typename T, typename R, typename LookupKey>
+  static R resolve_fixed_key(self_type &self) {
+    using request = request_type<T, false>;
+    if constexpr (resolve_status_v<request, LookupKey> ==
+                  binding_status::ambiguous) {
+      throw make_type_ambiguous_exception<typename request::lookup_type>();
+    } else {
+      return self.template resolve<T, LookupKey, R>(LookupKey{});
+    }
+  }
+
   template <typename Request,
             typename Factory = constructor<typename Request::value_type>,
             typename R = typename Request::result_type>
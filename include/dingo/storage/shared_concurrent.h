@@ -0,0 +1,92 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <dingo/core/config.h>
+
+#include <dingo/storage/shared.h>
+#include <dingo/storage/storage.h>
+#include <dingo/storage/type_storage_traits.h>
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+namespace dingo {
+// Shared storage that can be resolved from multiple threads. The instance is
+// constructed at most once under contention and published with release
+// semantics; once published, resolution is a single acquire load.
+struct shared_concurrent {};
+
+template <typename Type>
+struct storage_materialization_traits<shared_concurrent, Type>
+    : storage_materialization_traits<shared, Type> {};
+
+template <typename Type, typename U>
+struct storage_traits<
+    shared_concurrent, Type, U,
+    std::enable_if_t<!std::is_const_v<Type> && !std::is_reference_v<Type>>>
+    : storage_traits<shared, Type, U> {};
+
+namespace detail {
+template <typename Type, typename U>
+struct conversions<shared_concurrent, Type, U>
+    : type_storage_traits<shared_concurrent, Type, U> {};
+
+template <typename Type, typename StoredType, typename Factory,
+          typename Conversions>
+class storage<shared_concurrent, Type, StoredType, Factory, Conversions> {
+  using instance_type = storage_instance<shared, Type, StoredType, Factory>;
+
+  instance_type instance_;
+  std::atomic<bool> published_{false};
+  std::mutex mutex_;
+
+public:
+  template <typename... Args>
+  storage(Args &&...args) : instance_(std::forward<Args>(args)...) {}
+
+  using conversions = Conversions;
+  using type = Type;
+  using stored_type = StoredType;
+  using resolved_type = decltype(std::declval<instance_type &>().get());
+  using tag_type = shared_concurrent;
+
+  template <typename Context, typename Container>
+  decltype(auto) resolve(construction_scope scope, Context &context,
+                         Container &container) {
+    if (!published_.load(std::memory_order_acquire))
+      construct(scope, context, container);
+    return instance_.get();
+  }
+
+  bool is_resolved() const {
+    return published_.load(std::memory_order_acquire);
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_.store(false, std::memory_order_relaxed);
+    instance_.reset();
+  }
+
+private:
+  template <typename Context, typename Container>
+  DINGO_NOINLINE void construct(construction_scope scope, Context &context,
+                                Container &container) {
+    // Dependencies are resolved while the lock is held. Lock order follows the
+    // acyclic dependency graph, so concurrent construction cannot deadlock.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!published_.load(std::memory_order_relaxed)) {
+      instance_.construct(scope, context, container);
+      published_.store(true, std::memory_order_release);
+    }
+  }
+};
+} // namespace detail
+} // namespace dingo
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <dingo/core/config.h>
+#include <dingo/core/context_base.h>
 
 #include <dingo/factory/constructor.h>
 #include <dingo/storage/storage.h>
@@ -242,7 +243,13 @@ public:
   template <typename Context, typename Container>
   decltype(auto) resolve(construction_scope scope, Context &context,
                          Container &container) {
-    return Factory::template construct<Type>(scope, context, container);
+    if constexpr (is_runtime_context_v<Context>) {
+      return context.invoke_constructor([&]() -> decltype(auto) {
+        return Factory::template construct<Type>(scope, context, container);
+      });
+    } else {
+      return Factory::template construct<Type>(scope, context, container);
+    }
   }
 };
 
@@ -8,11 +8,14 @@
 #pragma once
 
 #include <dingo/core/config.h>
+#include <dingo/type/type_descriptor.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace dingo {
 template <typename... Types> struct type_list {};
@@ -21,21 +24,54 @@ template <typename T> struct type_list_iterator {
 };
 
 namespace detail {
-template <typename Accumulated, typename... Lists> struct type_list_cat_impl;
+// Concatenation consumes up to eight lists per step, so joining one list per
+// registration stays shallow and instantiates few intermediate lists.
+template <typename... Lists> struct type_list_cat_impl;
 
-template <typename... Accumulated>
-struct type_list_cat_impl<type_list<Accumulated...>> {
-  using type = type_list<Accumulated...>;
+template <> struct type_list_cat_impl<> {
+  using type = type_list<>;
+};
+
+template <typename... T0> struct type_list_cat_impl<type_list<T0...>> {
+  using type = type_list<T0...>;
+};
+
+template <typename... T0, typename... T1>
+struct type_list_cat_impl<type_list<T0...>, type_list<T1...>> {
+  using type = type_list<T0..., T1...>;
+};
+
+template <typename... T0, typename... T1, typename... T2>
+struct type_list_cat_impl<type_list<T0...>, type_list<T1...>,
+                          type_list<T2...>> {
+  using type = type_list<T0..., T1..., T2...>;
+};
+
+template <typename... T0, typename... T1, typename... T2, typename... T3>
+struct type_list_cat_impl<type_list<T0...>, type_list<T1...>, type_list<T2...>,
+                          type_list<T3...>> {
+  using type = type_list<T0..., T1..., T2..., T3...>;
 };
 
-template <typename... Accumulated, typename... Head, typename... Tail>
-struct type_list_cat_impl<type_list<Accumulated...>, type_list<Head...>,
-                          Tail...>
-    : type_list_cat_impl<type_list<Accumulated..., Head...>, Tail...> {};
+template <typename... T0, typename... T1, typename... T2, typename... T3,
+          typename... T4, typename... T5, typename... T6, typename... T7,
+          typename... Tail>
+struct type_list_cat_impl<type_list<T0...>, type_list<T1...>, type_list<T2...>,
+                          type_list<T3...>, type_list<T4...>, type_list<T5...>,
+                          type_list<T6...>, type_list<T7...>, Tail...>
+    : type_list_cat_impl<
+          type_list<T0..., T1..., T2..., T3..., T4..., T5..., T6..., T7...>,
+          Tail...> {};
+
+template <typename... T0, typename... T1, typename... T2, typename... T3,
+          typename... Tail>
+struct type_list_cat_impl<type_list<T0...>, type_list<T1...>, type_list<T2...>,
+                          type_list<T3...>, Tail...>
+    : type_list_cat_impl<type_list<T0..., T1..., T2..., T3...>, Tail...> {};
 } // namespace detail
 
 template <typename... Lists> struct type_list_cat {
-  using type = typename detail::type_list_cat_impl<type_list<>, Lists...>::type;
+  using type = typename detail::type_list_cat_impl<Lists...>::type;
 };
 
 template <typename... Lists>
@@ -60,6 +96,35 @@ struct type_list_head<type_list<Head, Tail...>> {
 template <typename List>
 using type_list_head_t = typename type_list_head<List>::type;
 
+namespace detail {
+template <size_t Index, typename T> struct type_list_at_entry {
+  static type_list_iterator<T> at(std::integral_constant<size_t, Index>);
+};
+
+template <typename List, typename Indexes> struct type_list_at_impl;
+
+// Every element is an overload keyed by its position, so indexing resolves
+// one call instead of walking the list. Positions past the end yield void.
+template <typename... Types, size_t... Indexes>
+struct type_list_at_impl<type_list<Types...>, std::index_sequence<Indexes...>>
+    : type_list_at_entry<Indexes, Types>... {
+  using type_list_at_entry<Indexes, Types>::at...;
+  static type_list_iterator<void> at(...);
+};
+
+template <typename List>
+using type_list_at_index =
+    type_list_at_impl<List, std::make_index_sequence<type_list_size_v<List>>>;
+} // namespace detail
+
+template <size_t Index, typename List> struct type_list_at {
+  using type = typename decltype(detail::type_list_at_index<List>::at(
+      std::integral_constant<size_t, Index>{}))::type;
+};
+
+template <size_t Index, typename List>
+using type_list_at_t = typename type_list_at<Index, List>::type;
+
 template <typename T, typename List> struct type_list_contains;
 
 // Compare the pack directly so membership checks do not instantiate a new
@@ -72,27 +137,151 @@ template <typename T, typename List>
 inline constexpr bool type_list_contains_v = type_list_contains<T, List>::value;
 
 namespace detail {
-template <typename Accumulated, typename Remaining>
-struct type_list_unique_impl;
-
-template <typename... Accumulated>
-struct type_list_unique_impl<type_list<Accumulated...>, type_list<>> {
-  using type = type_list<Accumulated...>;
-};
-
-template <typename... Accumulated, typename Head, typename... Tail>
-struct type_list_unique_impl<type_list<Accumulated...>,
-                             type_list<Head, Tail...>>
-    : type_list_unique_impl<
-          std::conditional_t<
-              type_list_contains_v<Head, type_list<Accumulated...>>,
-              type_list<Accumulated...>, type_list<Accumulated..., Head>>,
-          type_list<Tail...>> {};
+template <bool... Matches> constexpr size_t type_list_first_match() {
+  constexpr bool matches[] = {Matches..., true};
+  size_t index = 0;
+  while (!matches[index]) {
+    ++index;
+  }
+  return index;
+}
+} // namespace detail
+
+// Position of the first T in List, or the list size when T is not present.
+template <typename T, typename List> struct type_list_index_of;
+
+template <typename T, typename... Types>
+struct type_list_index_of<T, type_list<Types...>>
+    : std::integral_constant<size_t, detail::type_list_first_match<
+                                         std::is_same_v<T, Types>...>()> {};
+
+template <typename T, typename List>
+inline constexpr size_t type_list_index_of_v =
+    type_list_index_of<T, List>::value;
+
+namespace detail {
+template <typename T> inline constexpr char type_list_identity = 0;
+
+// FNV-1a over the type name; equal types hash equally, distinct types are told
+// apart by the address of their type_list_identity.
+template <typename T> constexpr uint64_t type_list_hash() {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : raw_type_name<T>()) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+template <size_t Size> struct type_list_occurrences {
+  bool first[Size ? Size : 1];
+};
+
+// Lists up to this size compare identities pairwise, which is cheaper than
+// instantiating a name hash for each type.
+constexpr size_t type_list_pairwise_limit = 16;
+
+template <size_t Size>
+constexpr bool type_list_hash_less(const uint64_t (&hashes)[Size], size_t lhs,
+                                   size_t rhs) {
+  return hashes[lhs] < hashes[rhs] ||
+         (hashes[lhs] == hashes[rhs] && lhs < rhs);
+}
+
+template <size_t Size>
+constexpr void type_list_sift_down(const uint64_t (&hashes)[Size],
+                                   size_t (&order)[Size], size_t root,
+                                   size_t end) {
+  while (2 * root + 1 < end) {
+    size_t child = 2 * root + 1;
+    if (child + 1 < end &&
+        type_list_hash_less(hashes, order[child], order[child + 1])) {
+      ++child;
+    }
+    if (!type_list_hash_less(hashes, order[root], order[child])) {
+      return;
+    }
+    size_t swapped = order[root];
+    order[root] = order[child];
+    order[child] = swapped;
+    root = child;
+  }
+}
+
+// Marks the first occurrence of each type. Longer lists are heap sorted by
+// (hash, position), so duplicates are only searched for among the few types
+// sharing a hash and the work stays O(n log n) instead of O(n^2).
+template <typename... Types>
+constexpr type_list_occurrences<sizeof...(Types)>
+type_list_first_occurrences() {
+  constexpr size_t size = sizeof...(Types);
+  type_list_occurrences<size> result{};
+  if constexpr (size > 0) {
+    const void *const identities[] = {&type_list_identity<Types>...};
+    if constexpr (size <= type_list_pairwise_limit) {
+      for (size_t i = 0; i < size; ++i) {
+        result.first[i] = true;
+        for (size_t j = 0; j < i && result.first[i]; ++j) {
+          result.first[i] = identities[i] != identities[j];
+        }
+      }
+    } else {
+      const uint64_t hashes[] = {type_list_hash<Types>()...};
+      size_t order[size] = {};
+      for (size_t i = 0; i < size; ++i) {
+        order[i] = i;
+      }
+      for (size_t i = size / 2; i-- > 0;) {
+        type_list_sift_down(hashes, order, i, size);
+      }
+      for (size_t end = size - 1; end > 0; --end) {
+        size_t swapped = order[0];
+        order[0] = order[end];
+        order[end] = swapped;
+        type_list_sift_down(hashes, order, 0, end);
+      }
+
+      size_t run = 0;
+      for (size_t i = 0; i < size; ++i) {
+        if (hashes[order[i]] != hashes[order[run]]) {
+          run = i;
+        }
+        // Within a run positions ascend, so any match is an earlier type.
+        bool first = true;
+        for (size_t j = run; j < i && first; ++j) {
+          first = identities[order[i]] != identities[order[j]];
+        }
+        result.first[order[i]] = first;
+      }
+    }
+  }
+  return result;
+}
+
+// Keeps the Values whose Keys at the same position are first occurrences.
+template <typename Keys, typename Values, typename Indexes>
+struct type_list_first_occurrence_filter;
+
+template <typename... Keys, typename... Values, size_t... Indexes>
+struct type_list_first_occurrence_filter<
+    type_list<Keys...>, type_list<Values...>, std::index_sequence<Indexes...>> {
+  static_assert(sizeof...(Keys) == sizeof...(Values));
+  static constexpr auto occurrences = type_list_first_occurrences<Keys...>();
+
+  using type = type_list_cat_t<
+      std::conditional_t<occurrences.first[Indexes], type_list<Values>,
+                         type_list<>>...>;
+};
+
+template <typename Keys, typename Values>
+using type_list_first_occurrence_filter_t =
+    typename type_list_first_occurrence_filter<
+        Keys, Values,
+        std::make_index_sequence<type_list_size_v<Values>>>::type;
 } // namespace detail
 
 template <typename List>
 using type_list_unique_t =
-    typename detail::type_list_unique_impl<type_list<>, List>::type;
+    detail::type_list_first_occurrence_filter_t<List, List>;
 
 template <typename Left, typename Right> struct type_list_merge {
   using type = type_list_unique_t<type_list_cat_t<Left, Right>>;
@@ -0,0 +1,116 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/static_container.h>
+#include <dingo/storage/external.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace dingo {
+namespace {
+struct handle_service {
+  virtual ~handle_service() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct handle_service_impl : handle_service {
+  int id() const override { return Id; }
+};
+
+struct handle_keyed_traits : dynamic_container_traits {
+  using lookup_definition_type =
+      lookups<associative<std::size_t, handle_service>>;
+};
+
+static_assert(std::is_same_v<decltype(std::declval<container<> &>()
+                                          .handle<handle_service &>()),
+                             binding_handle<handle_service &>>);
+} // namespace
+
+TEST(binding_handle_test, handle_holds_shared_instance_address) {
+  container<> container;
+  container.register_type<scope<shared>, storage<handle_service_impl<1>>,
+                          interfaces<handle_service>>();
+
+  auto handle = container.handle<handle_service &>();
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(&handle.get(), &container.resolve<handle_service &>());
+  EXPECT_EQ(handle->id(), 1);
+  EXPECT_EQ((*handle).id(), 1);
+
+  auto pointer = container.handle<handle_service *>();
+  EXPECT_EQ(pointer.get(), &handle.get());
+}
+
+TEST(binding_handle_test, handle_holds_external_instance_address) {
+  container<> container;
+  int value = 4;
+  container.register_type<scope<external>, storage<int &>>(value);
+
+  auto handle = container.handle<int &>();
+  EXPECT_EQ(&handle.get(), &value);
+}
+
+TEST(binding_handle_test, handle_resolves_keyed_binding) {
+  container<handle_keyed_traits> container;
+  container.register_type<scope<shared>, storage<handle_service_impl<1>>,
+                          interfaces<handle_service>>(
+      key_value{std::size_t{1}});
+  container.register_type<scope<shared>, storage<handle_service_impl<2>>,
+                          interfaces<handle_service>>(
+      key_value{std::size_t{2}});
+
+  auto handle = container.handle<handle_service &>(std::size_t{2});
+  EXPECT_EQ(handle->id(), 2);
+  EXPECT_EQ(&handle.get(),
+            &container.resolve<handle_service &>(std::size_t{2}));
+  EXPECT_THROW(container.handle<handle_service &>(std::size_t{3}),
+               type_not_found_exception);
+}
+
+TEST(binding_handle_test, handle_rejects_unstable_storage) {
+  container<> container;
+  container.register_type<scope<unique>, storage<handle_service_impl<1> *>,
+                          interfaces<handle_service>>();
+
+  EXPECT_THROW(container.handle<handle_service *>(),
+               type_not_convertible_exception);
+}
+
+TEST(binding_handle_test, handle_falls_back_to_parent) {
+  container<> parent;
+  parent.register_type<scope<shared>, storage<handle_service_impl<1>>,
+                       interfaces<handle_service>>();
+  container<dynamic_container_traits, std::allocator<char>, container<>> child(
+      &parent);
+
+  auto handle = child.handle<handle_service &>();
+  EXPECT_EQ(&handle.get(), &parent.resolve<handle_service &>());
+}
+
+TEST(binding_handle_test, handle_resolves_static_bindings) {
+  using source =
+      bindings<bind<scope<shared>, storage<handle_service_impl<3>>,
+                    interfaces<handle_service>>>;
+
+  container<source> mixed;
+  EXPECT_EQ(&mixed.handle<handle_service &>().get(),
+            &mixed.resolve<handle_service &>());
+
+  static_container<source> fixed;
+  auto handle = fixed.handle<handle_service *>();
+  EXPECT_EQ(handle->id(), 3);
+  EXPECT_EQ(handle.get(), fixed.resolve<handle_service *>());
+}
+} // namespace dingo
@@ -0,0 +1,142 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/static_container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct flattened_traits : static_container_traits {
+  using resolution_type = flattened_resolution;
+};
+
+static_assert(std::is_same_v<
+              detail::container_resolution_type_t<static_container_traits>,
+              layered_resolution>);
+static_assert(
+    std::is_same_v<detail::container_resolution_type_t<flattened_traits>,
+                   flattened_resolution>);
+
+struct flattened_counters {
+  static inline int config = 0;
+  static inline int service = 0;
+  static inline int failures = 0;
+};
+
+struct flattened_config {
+  flattened_config() { ++flattened_counters::config; }
+  int value = 3;
+};
+
+struct flattened_repository {
+  explicit flattened_repository(flattened_config &config)
+      : value(config.value * 2) {}
+  int value;
+};
+
+struct flattened_service {
+  flattened_service(flattened_repository &repository, flattened_config &config)
+      : value(repository.value + config.value) {
+    ++flattened_counters::service;
+  }
+  int value;
+};
+
+struct flattened_request {
+  flattened_request(flattened_service &service, flattened_config &config)
+      : value(service.value + config.value) {}
+  int value;
+};
+
+struct flattened_handler {
+  virtual ~flattened_handler() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct flattened_handler_impl : flattened_handler {
+  int id() const override { return Id; }
+};
+
+struct flattened_failing {
+  flattened_failing() {
+    if (flattened_counters::failures-- > 0) {
+      throw std::runtime_error("flattened_failing");
+    }
+  }
+};
+
+using flattened_source =
+    bindings<bind<scope<shared>, storage<flattened_config>>,
+             bind<scope<shared>, storage<flattened_repository>>,
+             bind<scope<shared>, storage<flattened_service>>,
+             bind<scope<unique>, storage<flattened_request>>,
+             bind<scope<shared>,
+                  storage<std::shared_ptr<flattened_handler_impl<1>>>,
+                  interfaces<flattened_handler>>,
+             bind<scope<shared>,
+                  storage<std::shared_ptr<flattened_handler_impl<2>>>,
+                  interfaces<flattened_handler>>,
+             bind<scope<shared>, storage<flattened_failing>>>;
+} // namespace
+
+TEST(flattened_resolution_test, shares_instances_across_the_graph) {
+  flattened_counters::config = 0;
+  flattened_counters::service = 0;
+  static_container<flattened_source, flattened_traits> container;
+
+  auto &service = container.resolve<flattened_service &>();
+  EXPECT_EQ(service.value, 9);
+  EXPECT_EQ(&container.resolve<flattened_service &>(), &service);
+  EXPECT_EQ(flattened_counters::config, 1);
+  EXPECT_EQ(flattened_counters::service, 1);
+}
+
+TEST(flattened_resolution_test, constructs_unique_instances) {
+  static_container<flattened_source, flattened_traits> container;
+
+  auto first = container.construct<flattened_request>();
+  auto second = container.construct<std::unique_ptr<flattened_request>>();
+  EXPECT_EQ(first.value, 12);
+  EXPECT_EQ(second->value, 12);
+}
+
+TEST(flattened_resolution_test, matches_layered_resolution) {
+  static_container<flattened_source, flattened_traits> flattened;
+  static_container<flattened_source> layered;
+
+  EXPECT_EQ(flattened.resolve<flattened_request>().value,
+            layered.resolve<flattened_request>().value);
+  EXPECT_EQ(flattened.construct<flattened_config>().value,
+            layered.construct<flattened_config>().value);
+}
+
+TEST(flattened_resolution_test, resolves_collections) {
+  static_container<flattened_source, flattened_traits> container;
+
+  auto handlers =
+      container.resolve<std::vector<std::shared_ptr<flattened_handler>>>();
+  ASSERT_EQ(handlers.size(), 2U);
+  EXPECT_EQ(handlers[0]->id() + handlers[1]->id(), 3);
+}
+
+TEST(flattened_resolution_test, retries_after_failed_construction) {
+  flattened_counters::failures = 1;
+  static_container<flattened_source, flattened_traits> container;
+
+  EXPECT_THROW(container.resolve<flattened_failing &>(), std::runtime_error);
+  auto &failing = container.resolve<flattened_failing &>();
+  EXPECT_EQ(&container.resolve<flattened_failing &>(), &failing);
+}
+} // namespace dingo
@@ -0,0 +1,134 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/static_container.h>
+#include <dingo/storage/external.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct batch_counted {
+  batch_counted() { ++instances; }
+  static int instances;
+};
+
+int batch_counted::instances = 0;
+
+struct batch_service {
+  explicit batch_service(batch_counted &counted_ref) : counted(counted_ref) {}
+  batch_counted &counted;
+};
+
+struct batch_throwing {
+  batch_throwing() { throw std::runtime_error("batch_throwing"); }
+};
+
+struct batch_processor {
+  virtual ~batch_processor() = default;
+  virtual std::size_t id() const = 0;
+};
+
+template <std::size_t Id> struct batch_processor_impl : batch_processor {
+  std::size_t id() const override { return Id; }
+};
+
+struct batch_traits : dynamic_container_traits {
+  using lookup_definition_type =
+      lookups<associative<std::size_t, batch_processor>>;
+};
+} // namespace
+
+TEST(resolve_all_test, resolves_tuple_of_requests) {
+  container<> container;
+  container.register_type<scope<shared>, storage<batch_counted>>();
+  container.register_type<scope<shared>, storage<batch_service>>();
+  container.register_type<scope<external>, storage<int>>(7);
+  container.register_type<scope<unique>, storage<std::unique_ptr<long>>>();
+
+  auto [counted, service, value, unique] =
+      container.resolve_all<batch_counted &, batch_service *, int,
+                            std::unique_ptr<long>>();
+  static_assert(std::is_same_v<decltype(counted), batch_counted &>);
+  static_assert(std::is_same_v<decltype(service), batch_service *>);
+  EXPECT_EQ(&counted, &container.resolve<batch_counted &>());
+  EXPECT_EQ(&service->counted, &counted);
+  EXPECT_EQ(value, 7);
+  EXPECT_NE(unique, nullptr);
+}
+
+TEST(resolve_all_test, failed_request_rolls_back_whole_batch) {
+  batch_counted::instances = 0;
+  container<> container;
+  container.register_type<scope<shared>, storage<batch_counted>>();
+  container.register_type<scope<shared>, storage<batch_throwing>>();
+
+  EXPECT_THROW((container.resolve_all<batch_counted &, batch_throwing &>()),
+               std::runtime_error);
+  EXPECT_EQ(batch_counted::instances, 1);
+
+  container.resolve<batch_counted &>();
+  EXPECT_EQ(batch_counted::instances, 2);
+}
+
+TEST(resolve_all_test, resolves_runtime_keys_into_output_iterator) {
+  container<batch_traits> container;
+  container.register_type<scope<shared>, storage<batch_processor_impl<1>>,
+                          interfaces<batch_processor>>(
+      key_value{std::size_t{1}});
+  container.register_type<scope<shared>, storage<batch_processor_impl<2>>,
+                          interfaces<batch_processor>>(
+      key_value{std::size_t{2}});
+
+  const std::vector<std::size_t> keys = {2, 1, 2};
+  std::vector<batch_processor *> processors;
+  container.resolve_all<batch_processor *>(keys.begin(), keys.end(),
+                                           std::back_inserter(processors));
+  ASSERT_EQ(processors.size(), 3u);
+  EXPECT_EQ(processors[0]->id(), 2u);
+  EXPECT_EQ(processors[1]->id(), 1u);
+  EXPECT_EQ(processors[2], processors[0]);
+
+  const std::vector<std::size_t> missing = {1, 3};
+  processors.clear();
+  EXPECT_THROW(container.resolve_all<batch_processor *>(
+                   missing.begin(), missing.end(),
+                   std::back_inserter(processors)),
+               type_not_found_exception);
+}
+
+TEST(resolve_all_test, mixed_container_resolves_static_and_runtime_bindings) {
+  using source = bindings<bind<scope<shared>, storage<batch_counted>>,
+                          bind<scope<shared>, storage<batch_service>>>;
+  container<source> container;
+  container.register_type<scope<external>, storage<int>>(3);
+
+  auto [service, value] = container.resolve_all<batch_service &, int &>();
+  EXPECT_EQ(&service.counted, &container.resolve<batch_counted &>());
+  EXPECT_EQ(value, 3);
+}
+
+TEST(resolve_all_test, static_container_resolves_tuple_of_requests) {
+  using source = bindings<bind<scope<shared>, storage<batch_counted>>,
+                          bind<scope<shared>, storage<batch_service>>>;
+  static_container<source> container;
+
+  auto [counted, service] =
+      container.resolve_all<batch_counted *, batch_service &>();
+  EXPECT_EQ(&service.counted, counted);
+}
+} // namespace dingo
@@ -0,0 +1,396 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime_container.h>
+#include <dingo/static_container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/shared_concurrent.h>
+#include <dingo/storage/shared_cyclical.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct warm_up_counters {
+  static inline int logger = 0;
+  static inline int database = 0;
+  static inline int service = 0;
+  static inline int handler = 0;
+  // Ids of warm_up_keyed_reader instances in construction order.
+  static inline std::vector<int> keyed_readers;
+};
+
+struct warm_up_logger {
+  warm_up_logger() { ++warm_up_counters::logger; }
+};
+
+struct warm_up_database {
+  explicit warm_up_database(warm_up_logger &) { ++warm_up_counters::database; }
+};
+
+struct warm_up_service {
+  warm_up_service(warm_up_database &, warm_up_logger &) {
+    ++warm_up_counters::service;
+  }
+};
+
+struct warm_up_handler {
+  warm_up_handler() { ++warm_up_counters::handler; }
+};
+
+struct warm_up_failing {
+  warm_up_failing() { throw std::runtime_error("failure"); }
+};
+
+struct warm_up_reader {
+  virtual ~warm_up_reader() = default;
+};
+
+struct warm_up_writer {
+  virtual ~warm_up_writer() = default;
+};
+
+struct warm_up_journal : warm_up_reader, warm_up_writer {
+  warm_up_journal() { ++warm_up_counters::handler; }
+};
+
+template <int Id> struct warm_up_keyed_reader : warm_up_reader {
+  warm_up_keyed_reader() { warm_up_counters::keyed_readers.push_back(Id); }
+};
+
+struct warm_up_test : testing::Test {
+  void SetUp() override { reset(); }
+
+  static void reset() {
+    warm_up_counters::logger = 0;
+    warm_up_counters::database = 0;
+    warm_up_counters::service = 0;
+    warm_up_counters::handler = 0;
+    warm_up_counters::keyed_readers.clear();
+  }
+
+  template <typename Container> static void register_graph(Container &c) {
+    c.template register_type<scope<shared>, storage<warm_up_service>>();
+    c.template register_type<scope<shared>, storage<warm_up_database>>();
+    c.template register_type<scope<shared>, storage<warm_up_logger>>();
+    c.template register_type<scope<unique>, storage<warm_up_handler>>();
+  }
+};
+
+template <typename Cardinality, typename Backend>
+struct warm_up_keyed_traits : dynamic_container_traits {
+  using lookup_definition_type =
+      lookups<associative<std::size_t, warm_up_logger, Cardinality, Backend>>;
+};
+
+template <typename Traits> void warm_up_keyed_bindings() {
+  runtime_container<Traits> container;
+  container.template register_type<scope<shared>, storage<warm_up_logger>>(
+      key_value{std::size_t{1}});
+  container.template register_type<scope<shared>, storage<warm_up_logger>>(
+      key_value{std::size_t{2}});
+
+  const int constructed = warm_up_counters::logger;
+  auto report = container.warm_up();
+  EXPECT_EQ(report.size(), 2u);
+  EXPECT_EQ(warm_up_counters::logger, constructed + 2);
+}
+
+struct warm_up_thread_executor {
+  ~warm_up_thread_executor() {
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  void operator()(std::function<void()> task) {
+    threads.emplace_back(std::move(task));
+  }
+
+  std::vector<std::thread> threads;
+};
+
+// Each instance waits until its sibling started too, so both are only
+// constructed when they run concurrently.
+template <int Id> struct warm_up_overlapping {
+  static inline std::atomic<int> started{0};
+  static inline std::atomic<bool> overlapped{false};
+
+  warm_up_overlapping() {
+    auto &counter = warm_up_overlapping<0>::started;
+    ++counter;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (counter.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    if (counter.load() >= 2) {
+      warm_up_overlapping<0>::overlapped = true;
+    }
+  }
+};
+
+struct warm_up_joined {
+  warm_up_joined(warm_up_overlapping<1> &, warm_up_overlapping<2> &) {}
+};
+
+bool contains(const warm_up_report &report, type_descriptor type) {
+  for (const auto &entry : report) {
+    if (entry.interface_type == type) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+TEST_F(warm_up_test, materializes_shared_bindings) {
+  container<> container;
+  register_graph(container);
+
+  auto report = container.warm_up();
+  EXPECT_EQ(report.size(), 3u);
+  EXPECT_TRUE(contains(report, describe_type<warm_up_service>()));
+  EXPECT_TRUE(contains(report, describe_type<warm_up_database>()));
+  EXPECT_TRUE(contains(report, describe_type<warm_up_logger>()));
+  EXPECT_FALSE(contains(report, describe_type<warm_up_handler>()));
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+  EXPECT_EQ(warm_up_counters::service, 1);
+  EXPECT_EQ(warm_up_counters::handler, 0);
+
+  auto &service = container.resolve<warm_up_service &>();
+  EXPECT_EQ(&service, &container.resolve<warm_up_service &>());
+  EXPECT_EQ(warm_up_counters::service, 1);
+
+  // Already materialized bindings are not constructed again.
+  container.warm_up();
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::service, 1);
+}
+
+TEST_F(warm_up_test, warm_up_materializes_shared_concurrent_bindings) {
+  container<> container;
+  container.register_type<scope<shared_concurrent>, storage<warm_up_logger>>();
+  container.register_type<scope<shared>, storage<warm_up_database>>();
+
+  auto report = container.warm_up();
+  EXPECT_EQ(report.size(), 2u);
+  EXPECT_TRUE(contains(report, describe_type<warm_up_logger>()));
+  EXPECT_TRUE(contains(report, describe_type<warm_up_database>()));
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+
+  container.resolve<warm_up_database &>();
+  EXPECT_EQ(warm_up_counters::logger, 1);
+}
+
+TEST_F(warm_up_test, warm_up_publishes_cached_address) {
+  container<> container;
+  register_graph(container);
+  container.warm_up();
+
+  auto &logger = container.resolve<warm_up_logger &>();
+  auto *pointer = container.resolve<warm_up_logger *>();
+  EXPECT_EQ(&logger, pointer);
+  EXPECT_EQ(&logger, &container.resolve<warm_up_logger &>());
+}
+
+TEST_F(warm_up_test, warm_up_filters_interfaces) {
+  container<> container;
+  register_graph(container);
+
+  auto report = container.warm_up<warm_up_database>();
+  ASSERT_EQ(report.size(), 1u);
+  EXPECT_EQ(report[0].interface_type, describe_type<warm_up_database>());
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+  EXPECT_EQ(warm_up_counters::service, 0);
+}
+
+TEST_F(warm_up_test, warm_up_materializes_shared_cyclical_bindings) {
+  container<> container;
+  container.register_type<scope<shared_cyclical>, storage<warm_up_logger>>();
+
+  auto report = container.warm_up();
+  ASSERT_EQ(report.size(), 1u);
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  container.resolve<warm_up_logger &>();
+  EXPECT_EQ(warm_up_counters::logger, 1);
+}
+
+TEST_F(warm_up_test, warm_up_rolls_back_on_failure) {
+  container<> container;
+  container.register_type<scope<shared>, storage<warm_up_logger>>();
+  container.register_type<scope<shared>, storage<warm_up_failing>>();
+
+  EXPECT_THROW(container.warm_up(), std::runtime_error);
+  EXPECT_NO_THROW(container.warm_up<warm_up_logger>());
+  EXPECT_EQ(&container.resolve<warm_up_logger &>(),
+            &container.resolve<warm_up_logger &>());
+}
+
+TEST_F(warm_up_test, warm_up_visits_every_lookup_backend) {
+  warm_up_keyed_bindings<warm_up_keyed_traits<one, ordered>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<many, ordered>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<one, unordered>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<one, array<4>>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<many, array<4>>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<one, flat_unordered>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<many, flat_unordered>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<one, sorted>>();
+  warm_up_keyed_bindings<warm_up_keyed_traits<many, sorted>>();
+}
+
+TEST_F(warm_up_test, warm_up_materializes_bindings_in_lookup_order) {
+  struct traits : dynamic_container_traits {
+    using lookup_definition_type =
+        lookups<associative<std::size_t, warm_up_reader, one, ordered>>;
+  };
+
+  runtime_container<traits> container;
+  container.register_type<scope<shared>, storage<warm_up_keyed_reader<3>>,
+                          interfaces<warm_up_reader>>(
+      key_value{std::size_t{3}});
+  container.register_type<scope<shared>, storage<warm_up_keyed_reader<1>>,
+                          interfaces<warm_up_reader>>(
+      key_value{std::size_t{1}});
+  container.register_type<scope<shared>, storage<warm_up_keyed_reader<2>>,
+                          interfaces<warm_up_reader>>(
+      key_value{std::size_t{2}});
+
+  EXPECT_EQ(container.warm_up().size(), 3u);
+  EXPECT_EQ(warm_up_counters::keyed_readers, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(warm_up_test, warm_up_includes_static_bindings) {
+  using source = bindings<bind<scope<shared>, storage<warm_up_logger>>>;
+  container<source> container;
+  container.register_type<scope<shared>, storage<warm_up_database>>();
+
+  auto report = container.warm_up();
+  ASSERT_EQ(report.size(), 2u);
+  EXPECT_EQ(report[0].interface_type, describe_type<warm_up_logger>());
+  EXPECT_EQ(report[1].interface_type, describe_type<warm_up_database>());
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+}
+
+TEST_F(warm_up_test, static_warm_up_builds_graph_by_layers) {
+  using source = bindings<
+      bind<scope<shared>, storage<warm_up_service>,
+           factory<constructor<warm_up_service(warm_up_database &,
+                                               warm_up_logger &)>>>,
+      bind<scope<shared>, storage<warm_up_database>,
+           factory<constructor<warm_up_database(warm_up_logger &)>>>,
+      bind<scope<shared>, storage<warm_up_logger>>,
+      bind<scope<unique>, storage<warm_up_handler>>>;
+  static_container<source> container;
+
+  auto report = container.warm_up();
+  ASSERT_EQ(report.size(), 3u);
+  EXPECT_EQ(report[0].interface_type, describe_type<warm_up_logger>());
+  EXPECT_EQ(report[1].interface_type, describe_type<warm_up_database>());
+  EXPECT_EQ(report[2].interface_type, describe_type<warm_up_service>());
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+  EXPECT_EQ(warm_up_counters::service, 1);
+  EXPECT_EQ(warm_up_counters::handler, 0);
+}
+
+TEST_F(warm_up_test, static_warm_up_materializes_shared_concurrent_bindings) {
+  using source = bindings<
+      bind<scope<shared_concurrent>, storage<warm_up_logger>>,
+      bind<scope<shared>, storage<warm_up_database>,
+           factory<constructor<warm_up_database(warm_up_logger &)>>>>;
+  static_container<source> container;
+
+  warm_up_thread_executor executor;
+  auto report = container.warm_up(executor);
+  ASSERT_EQ(report.size(), 2u);
+  EXPECT_EQ(report[0].interface_type, describe_type<warm_up_logger>());
+  EXPECT_EQ(report[1].interface_type, describe_type<warm_up_database>());
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+}
+
+TEST_F(warm_up_test, static_warm_up_constructs_shared_model_once) {
+  using source = bindings<
+      bind<scope<shared>, storage<warm_up_logger>>,
+      bind<scope<shared>, storage<warm_up_journal>,
+           interfaces<warm_up_reader, warm_up_writer>>,
+      bind<scope<shared>, storage<warm_up_database>,
+           factory<constructor<warm_up_database(warm_up_logger &)>>>>;
+  static_container<source> container;
+
+  auto report = container.warm_up();
+  ASSERT_EQ(report.size(), 3u);
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+  EXPECT_EQ(warm_up_counters::handler, 1);
+  EXPECT_EQ(&dynamic_cast<warm_up_journal &>(
+                container.resolve<warm_up_reader &>()),
+            &dynamic_cast<warm_up_journal &>(
+                container.resolve<warm_up_writer &>()));
+  EXPECT_EQ(warm_up_counters::handler, 1);
+}
+
+TEST_F(warm_up_test, static_warm_up_constructs_detected_bindings_inline) {
+  using source =
+      bindings<bind<scope<shared>, storage<warm_up_service>>,
+               bind<scope<shared>, storage<warm_up_database>>,
+               bind<scope<shared>, storage<warm_up_logger>>>;
+  static_container<source> container;
+
+  warm_up_thread_executor executor;
+  auto report = container.warm_up(executor);
+  ASSERT_EQ(report.size(), 3u);
+  // Only the logger has a dependency list the graph knows about.
+  EXPECT_EQ(executor.threads.size(), 1u);
+  EXPECT_EQ(warm_up_counters::logger, 1);
+  EXPECT_EQ(warm_up_counters::database, 1);
+  EXPECT_EQ(warm_up_counters::service, 1);
+}
+
+TEST_F(warm_up_test, static_warm_up_constructs_layer_concurrently) {
+  using source = bindings<
+      bind<scope<shared>, storage<warm_up_joined>,
+           factory<constructor<warm_up_joined(warm_up_overlapping<1> &,
+                                              warm_up_overlapping<2> &)>>>,
+      bind<scope<shared>, storage<warm_up_overlapping<1>>>,
+      bind<scope<shared>, storage<warm_up_overlapping<2>>>>;
+  static_container<source> container;
+
+  warm_up_report report;
+  {
+    warm_up_thread_executor executor;
+    report = container.warm_up(executor);
+  }
+  ASSERT_EQ(report.size(), 3u);
+  EXPECT_EQ(report[2].interface_type, describe_type<warm_up_joined>());
+  EXPECT_TRUE(warm_up_overlapping<0>::overlapped);
+}
+
+TEST_F(warm_up_test, static_warm_up_rethrows_task_failure) {
+  using source = bindings<bind<scope<shared>, storage<warm_up_logger>>,
+                          bind<scope<shared>, storage<warm_up_failing>>>;
+  static_container<source> container;
+
+  warm_up_thread_executor executor;
+  EXPECT_THROW(container.warm_up(executor), std::runtime_error);
+}
+} // namespace dingo
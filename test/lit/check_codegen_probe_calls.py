@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+
+import re
+import sys
+from pathlib import Path
+
+
+# Each flattened probe is checked against a hand-written probe building the
+# same graph with plain constructor calls. The flattened probe may enter at
+# most one out-of-line function of the object (its construction plan) and
+# everything it reaches may call only what the hand-written probe calls.
+FLATTENED_PROBES = {
+    "probe_static_resolution_flattened_unique_graph": (
+        "probe_handwritten_unique_graph"
+    ),
+    "probe_static_resolution_flattened_shared_graph": (
+        "probe_handwritten_shared_graph"
+    ),
+}
+
+# Landing pads of the construction plan continue unwinding through these.
+EXCEPTION_SUPPORT = {"_Unwind_Resume"}
+
+MAX_PLAN_FUNCTIONS = 1
+
+SECTION_RE = re.compile(r"^Disassembly of section (\S+):$")
+SYMBOL_RE = re.compile(r"^([0-9a-fA-F]+) <([^>]+)>:$")
+BRANCH_RE = re.compile(
+    r"^\s*[0-9a-fA-F]+:\s+(call|jmp|bl|b)\S*\s+[0-9a-fA-F]+\s+"
+    r"<([^>+]+)(?:\+0x[0-9a-fA-F]+)?>"
+)
+RELOCATION_RE = re.compile(
+    r"^\s*[0-9a-fA-F]+:\s+R_\S+\s+(\S+?)(?:([-+])0x([0-9a-fA-F]+))?$"
+)
+# Branches into a local section are relocated against the section symbol with
+# the displacement size folded into the addend.
+BRANCH_DISPLACEMENT = 4
+
+
+def function_name(symbol: str) -> str:
+    return symbol[: -len(".cold")] if symbol.endswith(".cold") else symbol
+
+
+def load_branch_targets(path: Path) -> dict[str, set[str]]:
+    lines = path.read_text().splitlines()
+
+    section_symbols: dict[str, list[tuple[int, str]]] = {}
+    section = ""
+    for line in lines:
+        match = SECTION_RE.match(line.strip())
+        if match is not None:
+            section = match.group(1)
+            continue
+        match = SYMBOL_RE.match(line.strip())
+        if match is not None:
+            section_symbols.setdefault(section, []).append(
+                (int(match.group(1), 16), function_name(match.group(2)))
+            )
+
+    def resolve(relocation: re.Match[str]) -> str:
+        symbol = relocation.group(1)
+        if symbol not in section_symbols:
+            return symbol
+        offset = int(relocation.group(3) or "0", 16)
+        if relocation.group(2) == "-":
+            offset = -offset
+        offset += BRANCH_DISPLACEMENT
+        candidates = [name for start, name in section_symbols[symbol]
+                      if start <= offset]
+        return candidates[-1] if candidates else symbol
+
+    targets: dict[str, set[str]] = {}
+    current: str | None = None
+    pending: str | None = None
+
+    def flush() -> None:
+        nonlocal pending
+        if current is not None and pending is not None:
+            target = function_name(pending)
+            if target != current:
+                targets[current].add(target)
+        pending = None
+
+    for raw_line in lines:
+        line = raw_line.rstrip()
+        match = SYMBOL_RE.match(line.strip())
+        if match is not None:
+            flush()
+            current = function_name(match.group(2))
+            targets.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        relocation = RELOCATION_RE.match(line)
+        if relocation is not None:
+            if pending is not None:
+                pending = resolve(relocation)
+            flush()
+            continue
+        flush()
+        branch = BRANCH_RE.match(line)
+        if branch is not None:
+            pending = branch.group(2)
+    flush()
+    return targets
+
+
+def reachable(
+    targets: dict[str, set[str]], root: str
+) -> tuple[set[str], set[str]]:
+    functions: set[str] = set()
+    external: set[str] = set()
+    pending = list(targets[root])
+    while pending:
+        symbol = pending.pop()
+        if symbol in targets:
+            if symbol not in functions:
+                functions.add(symbol)
+                pending.extend(targets[symbol])
+        else:
+            external.add(symbol)
+    functions.discard(root)
+    return functions, external
+
+
+def main() -> int:
+    if len(sys.argv) != 2:
+        print(
+            "usage: check_codegen_probe_calls.py <objdump-with-relocations>",
+            file=sys.stderr,
+        )
+        return 2
+
+    targets = load_branch_targets(Path(sys.argv[1]))
+    symbols = set(FLATTENED_PROBES) | set(FLATTENED_PROBES.values())
+    missing = sorted(symbols - targets.keys())
+    if missing:
+        print(f"missing probe disassembly: {', '.join(missing)}", file=sys.stderr)
+        return 1
+
+    failed = False
+    for flattened, handwritten in FLATTENED_PROBES.items():
+        _, allowed = reachable(targets, handwritten)
+        functions, external = reachable(targets, flattened)
+        if len(functions) > MAX_PLAN_FUNCTIONS:
+            print(
+                f"{flattened} reaches {len(functions)} out-of-line functions, "
+                f"expected at most {MAX_PLAN_FUNCTIONS}: "
+                f"{', '.join(sorted(functions))}",
+                file=sys.stderr,
+            )
+            failed = True
+        extra = sorted(external - allowed - EXCEPTION_SUPPORT)
+        if extra:
+            print(
+                f"{flattened} calls beyond {handwritten}: {', '.join(extra)}",
+                file=sys.stderr,
+            )
+            failed = True
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
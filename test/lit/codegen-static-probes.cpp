@@ -4,6 +4,8 @@
 // RUN: %python %dingo_lit_root/check_codegen_probe_sizes.py %t.nm
 // RUN: objdump -d --no-show-raw-insn %t.o | c++filt > %t.objdump
 // RUN: %python %dingo_lit_root/check_codegen_probe_instructions.py %t.objdump
+// RUN: objdump -dr --no-show-raw-insn %t.o > %t.calls
+// RUN: %python %dingo_lit_root/check_codegen_probe_calls.py %t.calls
 
 #include <dingo/container.h>
 #include <dingo/static_container.h>
@@ -21,6 +23,10 @@
 
 using namespace dingo;
 
+// Nodes of the deep graphs below call an opaque function, so the flattened
+// probes can be compared with hand-written construction.
+int graph_value(int value);
+
 namespace {
 
 struct config {
@@ -129,6 +135,55 @@ void register_runtime_external_wrapper_binding(
       std::move(config));
 }
 
+struct graph_leaf {
+  graph_leaf() : value(graph_value(0)) {}
+  int value;
+};
+
+template <int Id, typename First, typename Second> struct shared_graph_node {
+  shared_graph_node(First &first, Second &second)
+      : value(graph_value(first.value + second.value + Id)) {}
+  int value;
+};
+
+using shared_graph_1 = shared_graph_node<1, graph_leaf, graph_leaf>;
+using shared_graph_2 = shared_graph_node<2, shared_graph_1, graph_leaf>;
+using shared_graph_3 = shared_graph_node<3, shared_graph_2, shared_graph_1>;
+using shared_graph_4 = shared_graph_node<4, shared_graph_3, shared_graph_2>;
+using shared_graph_5 = shared_graph_node<5, shared_graph_4, shared_graph_3>;
+using shared_graph_6 = shared_graph_node<6, shared_graph_5, shared_graph_4>;
+
+template <int Id, typename First, typename Second> struct unique_graph_node {
+  unique_graph_node(First first, Second second)
+      : value(graph_value(first.value + second.value + Id)) {}
+  int value;
+};
+
+using unique_graph_1 = unique_graph_node<1, graph_leaf, graph_leaf>;
+using unique_graph_2 = unique_graph_node<2, unique_graph_1, graph_leaf>;
+using unique_graph_3 = unique_graph_node<3, unique_graph_2, unique_graph_1>;
+using unique_graph_4 = unique_graph_node<4, unique_graph_3, unique_graph_2>;
+
+using static_shared_graph_source =
+    bindings<bind<scope<shared>, storage<graph_leaf>>,
+             bind<scope<shared>, storage<shared_graph_1>>,
+             bind<scope<shared>, storage<shared_graph_2>>,
+             bind<scope<shared>, storage<shared_graph_3>>,
+             bind<scope<shared>, storage<shared_graph_4>>,
+             bind<scope<shared>, storage<shared_graph_5>>,
+             bind<scope<shared>, storage<shared_graph_6>>>;
+
+using static_unique_graph_source =
+    bindings<bind<scope<unique>, storage<graph_leaf>>,
+             bind<scope<unique>, storage<unique_graph_1>>,
+             bind<scope<unique>, storage<unique_graph_2>>,
+             bind<scope<unique>, storage<unique_graph_3>>,
+             bind<scope<unique>, storage<unique_graph_4>>>;
+
+struct flattened_traits : static_container_traits {
+  using resolution_type = flattened_resolution;
+};
+
 using shared_config_static_source =
     static_bindings_source_t<static_wrapper_source>;
 using shared_config_selection = detail::static_binding_t<
@@ -370,3 +425,33 @@ probe_static_resolution_mixed_container_collection_sum() {
   auto values = mixed_container.resolve<std::vector<std::shared_ptr<iface>>>();
   return values[0]->read() + values[1]->read();
 }
+
+extern "C" [[gnu::noinline]] int
+probe_static_resolution_flattened_shared_graph() {
+  static_container<static_shared_graph_source, flattened_traits> container;
+  return container.resolve<shared_graph_6 &>().value;
+}
+
+extern "C" [[gnu::noinline]] int probe_handwritten_shared_graph() {
+  graph_leaf leaf;
+  shared_graph_1 node_1(leaf, leaf);
+  shared_graph_2 node_2(node_1, leaf);
+  shared_graph_3 node_3(node_2, node_1);
+  shared_graph_4 node_4(node_3, node_2);
+  shared_graph_5 node_5(node_4, node_3);
+  shared_graph_6 node_6(node_5, node_4);
+  return node_6.value;
+}
+
+extern "C" [[gnu::noinline]] int
+probe_static_resolution_flattened_unique_graph() {
+  static_container<static_unique_graph_source, flattened_traits> container;
+  return container.construct<unique_graph_4>().value;
+}
+
+extern "C" [[gnu::noinline]] int probe_handwritten_unique_graph() {
+  auto node_1 = [] { return unique_graph_1{graph_leaf{}, graph_leaf{}}; };
+  auto node_2 = [&] { return unique_graph_2{node_1(), graph_leaf{}}; };
+  auto node_3 = [&] { return unique_graph_3{node_2(), node_1()}; };
+  return unique_graph_4{node_3(), node_2()}.value;
+}
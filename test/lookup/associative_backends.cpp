@@ -397,6 +397,318 @@ TEST(associative_backend_test,
           .empty());
 }
 
+TEST(associative_backend_test, flat_unordered_one_uses_key_value_lookup) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct first_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct second_processor : processor {
+    int id() const override { return 2; }
+  };
+
+  struct traits : dynamic_container_traits {
+    using lookup_definition_type =
+        lookups<associative<std::size_t, processor, one, flat_unordered>>;
+  };
+
+  container<traits> container;
+  container.template register_type<scope<shared>, storage<first_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(7)});
+
+  auto &first = container.template resolve<processor &>(std::size_t(7));
+  ASSERT_EQ(first.id(), 1);
+  EXPECT_THROW(
+      (container.template register_type<
+          scope<shared>, storage<second_processor>, interfaces<processor>>(
+          dingo::key_value{std::size_t(7)})),
+      lookup_already_registered_exception);
+  ASSERT_EQ(&container.template resolve<processor &>(std::size_t(7)), &first);
+  container.template register_type<scope<shared>, storage<second_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(8)});
+  ASSERT_EQ(container.template resolve<processor &>(std::size_t(8)).id(), 2);
+  ASSERT_EQ(container.template resolve<processor &>(std::size_t(7)).id(), 1);
+  EXPECT_THROW((container.template resolve<processor &>(std::size_t(9))),
+               type_not_found_exception);
+}
+
+TEST(associative_backend_test, flat_unordered_many_uses_contiguous_buckets) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct first_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct second_processor : processor {
+    int id() const override { return 2; }
+  };
+
+  struct traits : dynamic_container_traits {
+    using lookup_definition_type =
+        lookups<associative<std::size_t, processor, many, flat_unordered>>;
+  };
+
+  container<traits> container;
+  container.template register_type<scope<shared>, storage<first_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(7)});
+  container.template register_type<scope<shared>, storage<second_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(7)});
+
+  auto values =
+      container.template resolve<std::vector<processor *>>(std::size_t(7));
+  ASSERT_EQ(values.size(), 2);
+  std::vector<int> ids;
+  for (auto *value : values) {
+    ids.push_back(value->id());
+  }
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ(ids, (std::vector<int>{1, 2}));
+  EXPECT_THROW((container.template resolve<processor &>(std::size_t(7))),
+               type_ambiguous_exception);
+  ASSERT_TRUE(
+      container.template resolve<std::vector<processor *>>(std::size_t(8))
+          .empty());
+}
+
+TEST(associative_backend_test, flat_unordered_storage_grows_and_erases) {
+  using allocator_type = std::allocator<char>;
+  using one_storage = flat_unordered::storage<std::size_t, std::size_t, one,
+                                              allocator_type>;
+  using many_storage = flat_unordered::storage<std::size_t, std::size_t, many,
+                                               allocator_type>;
+  allocator_type allocator;
+
+  one_storage values(allocator);
+  constexpr std::size_t count = 1000;
+  for (std::size_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(values.try_emplace(i, i * 2).second);
+  }
+  ASSERT_FALSE(values.try_emplace(3, 0).second);
+  for (std::size_t i = 0; i < count; i += 2) {
+    values.erase(values.find(i));
+  }
+  for (std::size_t round = 0; round < 4; ++round) {
+    for (std::size_t i = count; i < count * 2; ++i) {
+      ASSERT_TRUE(values.try_emplace(i, i * 2).second);
+    }
+    for (std::size_t i = count; i < count * 2; ++i) {
+      values.erase(values.find(i));
+    }
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    auto it = values.find(i);
+    if (i % 2 == 0) {
+      ASSERT_TRUE(it == values.end());
+    } else {
+      ASSERT_TRUE(it != values.end());
+      ASSERT_EQ(*it, i * 2);
+    }
+  }
+
+  many_storage buckets(allocator);
+  for (std::size_t i = 0; i < count; ++i) {
+    buckets.emplace(i % 10, i);
+  }
+  auto [first, last] = buckets.equal_range(3);
+  std::size_t rows = 0;
+  for (auto it = first; it != last; ++it) {
+    ASSERT_EQ(*it % 10, 3U);
+    ++rows;
+  }
+  ASSERT_EQ(rows, count / 10);
+  while (buckets.find(3) != buckets.end()) {
+    buckets.erase(buckets.find(3));
+  }
+  ASSERT_TRUE(buckets.equal_range(3).first == buckets.equal_range(3).second);
+  ASSERT_TRUE(buckets.find(4) != buckets.end());
+}
+
+TEST(associative_backend_test, sorted_one_uses_key_value_lookup) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct first_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct second_processor : processor {
+    int id() const override { return 2; }
+  };
+  struct third_processor : processor {
+    int id() const override { return 3; }
+  };
+
+  struct traits : dynamic_container_traits {
+    using lookup_definition_type =
+        lookups<associative<std::size_t, processor, one, sorted>>;
+  };
+
+  container<traits> container;
+  container.template register_type<scope<shared>, storage<third_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(9)});
+  container.template register_type<scope<shared>, storage<first_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(7)});
+  auto &first = container.template resolve<processor &>(std::size_t(7));
+  ASSERT_EQ(first.id(), 1);
+  EXPECT_THROW(
+      (container.template register_type<
+          scope<shared>, storage<second_processor>, interfaces<processor>>(
+          dingo::key_value{std::size_t(7)})),
+      lookup_already_registered_exception);
+  ASSERT_EQ(&container.template resolve<processor &>(std::size_t(7)), &first);
+  container.template register_type<scope<shared>, storage<second_processor>,
+                                   interfaces<processor>>(
+      dingo::key_value{std::size_t(8)});
+  ASSERT_EQ(container.template resolve<processor &>(std::size_t(7)).id(), 1);
+  ASSERT_EQ(container.template resolve<processor &>(std::size_t(8)).id(), 2);
+  ASSERT_EQ(container.template resolve<processor &>(std::size_t(9)).id(), 3);
+  EXPECT_THROW((container.template resolve<processor &>(std::size_t(6))),
+               type_not_found_exception);
+}
+
+TEST(associative_backend_test,
+     sorted_failed_registration_rolls_back_key_value_rows) {
+  struct processor {
+    virtual ~processor() = default;
+  };
+  struct handler {
+    virtual ~handler() = default;
+  };
+  struct processor_impl : processor, handler {};
+
+  struct traits : dynamic_container_traits {
+    using lookup_definition_type =
+        lookups<associative<std::size_t, processor, many, sorted>,
+                associative<std::size_t, handler, one, array<1>>>;
+  };
+
+  container<traits> container;
+  EXPECT_THROW((container.template register_type<
+                   scope<shared>, storage<processor_impl>,
+                   interfaces<processor, handler>>(
+                   dingo::key_value{std::size_t(1)})),
+               std::out_of_range);
+  ASSERT_TRUE(
+      container.template resolve<std::vector<processor *>>(std::size_t(1))
+          .empty());
+
+  container.template register_type<scope<shared>, storage<processor_impl>,
+                                   interfaces<processor, handler>>(
+      dingo::key_value{std::size_t(0)});
+  ASSERT_EQ(
+      container.template resolve<std::vector<processor *>>(std::size_t(0))
+          .size(),
+      1U);
+}
+
+static_assert(detail::has_lookup_storage_commit_v<
+              sorted::storage<int, int, one, std::allocator<char>>>);
+static_assert(!detail::has_lookup_storage_commit_v<
+              ordered::storage<int, int, one, std::allocator<char>>>);
+
+TEST(associative_backend_test, sorted_storage_merges_rows_on_commit) {
+  using allocator_type = std::allocator<char>;
+  using one_storage = sorted::storage<int, int, one, allocator_type>;
+  using many_storage = sorted::storage<int, int, many, allocator_type>;
+  allocator_type allocator;
+
+  one_storage values(allocator);
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_TRUE(values.try_emplace((i * 37) % 64, i).second);
+  }
+  ASSERT_FALSE(values.try_emplace(5, 0).second);
+  values.commit();
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(*values.find((i * 37) % 64), i);
+  }
+  ASSERT_TRUE(values.find(64) == values.end());
+  ASSERT_TRUE(values.try_emplace(100, 100).second);
+  ASSERT_EQ(*values.find(100), 100);
+  values.erase(values.find(100));
+  values.erase(values.find(0));
+  values.commit();
+  ASSERT_TRUE(values.find(0) == values.end());
+  ASSERT_TRUE(values.find(100) == values.end());
+  ASSERT_EQ(*values.find(37), 1);
+
+  many_storage rows(allocator);
+  rows.emplace(2, 20);
+  rows.emplace(1, 10);
+  rows.emplace(2, 21);
+  rows.commit();
+  rows.emplace(2, 22);
+  rows.emplace(3, 30);
+  auto collect = [&rows](int key) {
+    std::vector<int> result;
+    auto [first, last] = rows.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+      result.push_back(*it);
+    }
+    return result;
+  };
+  ASSERT_EQ(collect(2), (std::vector<int>{20, 21, 22}));
+  rows.commit();
+  ASSERT_EQ(collect(1), (std::vector<int>{10}));
+  ASSERT_EQ(collect(2), (std::vector<int>{20, 21, 22}));
+  ASSERT_EQ(collect(3), (std::vector<int>{30}));
+  ASSERT_TRUE(collect(4).empty());
+}
+
+// Counts the allocations of a storage and of its rebound copies.
+template <typename T> struct counted_allocator {
+  using value_type = T;
+
+  explicit counted_allocator(std::size_t *allocations_ref)
+      : allocations(allocations_ref) {}
+  template <typename U>
+  counted_allocator(const counted_allocator<U> &other)
+      : allocations(other.allocations) {}
+
+  T *allocate(std::size_t n) {
+    ++*allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  template <typename U> bool operator==(const counted_allocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const counted_allocator<U> &) const {
+    return false;
+  }
+
+  std::size_t *allocations;
+};
+
+TEST(associative_backend_test, sorted_storage_amortizes_merges) {
+  constexpr int count = 4096;
+  std::size_t allocations = 0;
+  counted_allocator<char> allocator(&allocations);
+  sorted::storage<int, int, one, counted_allocator<char>> values(allocator);
+
+  // One registration transaction per row, as with register_type() calls.
+  for (int i = 0; i < count; ++i) {
+    ASSERT_TRUE(values.try_emplace((i * 37) % count, i).second);
+    values.commit();
+  }
+  for (int i = 0; i < count; ++i) {
+    ASSERT_EQ(*values.find((i * 37) % count), i);
+  }
+  ASSERT_TRUE(values.find(count) == values.end());
+  // A merge per commit would allocate three arrays per row.
+  EXPECT_LT(allocations, std::size_t(count));
+}
+
 TEST(associative_backend_test, custom_backend_uses_stl_like_try_emplace) {
   struct processor {
     virtual ~processor() = default;
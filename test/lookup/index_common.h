@@ -8,6 +8,7 @@
 #pragma once
 
 #include <dingo/container.h>
+#include <dingo/rtti/interned_provider.h>
 #include <dingo/rtti/typeid_provider.h>
 #include <dingo/runtime/lookup_index.h>
 #include <dingo/storage/shared.h>
@@ -40,6 +41,13 @@ template <typename Backend> struct base_one_test_traits {
   using lookup_definition_type = lookups<base<one, Backend>>;
 };
 
+// The dense backend positions rows by dense type ids.
+template <> struct base_one_test_traits<dense> {
+  using rtti_type = rtti<interned_provider>;
+  using allocator_type = std::allocator<char>;
+  using lookup_definition_type = lookups<base<one, dense>>;
+};
+
 template <typename Backend> struct base_many_test_traits {
   using rtti_type = rtti<typeid_provider>;
   using allocator_type = std::allocator<char>;
@@ -17,6 +17,154 @@ TEST(index_test, base_one_unordered_resolves_implicit_static_keys) {
   expect_base_one_backend_resolves_implicit_static_keys<unordered>();
 }
 
+TEST(index_test, base_one_dense_resolves_implicit_static_keys) {
+  expect_base_one_backend_resolves_implicit_static_keys<dense>();
+}
+
+TEST(index_test, base_one_dense_keeps_typed_keys_apart) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct unkeyed_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct first_keyed_processor : processor {
+    int id() const override { return 2; }
+  };
+  struct second_keyed_processor : processor {
+    int id() const override { return 3; }
+  };
+  struct first_key {};
+  struct second_key {};
+
+  container<base_one_test_traits<dense>> container;
+  container.template register_type<
+      scope<shared>, storage<first_keyed_processor>, interfaces<processor>,
+      key_type<first_key>>();
+  container.template register_type<scope<shared>, storage<unkeyed_processor>,
+                                   interfaces<processor>>();
+  container.template register_type<
+      scope<shared>, storage<second_keyed_processor>, interfaces<processor>,
+      key_type<second_key>>();
+
+  EXPECT_EQ(container.template resolve<processor &>().id(), 1);
+  EXPECT_EQ(
+      container.template resolve<processor &>(key_type<first_key>{}).id(), 2);
+  EXPECT_EQ(
+      container.template resolve<processor &>(key_type<second_key>{}).id(), 3);
+  EXPECT_THROW((container.template register_type<scope<shared>,
+                                                 storage<unkeyed_processor>,
+                                                 interfaces<processor>>()),
+               lookup_already_registered_exception);
+}
+
+TEST(index_test, base_one_dense_resolves_keyed_interfaces) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct first_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct second_processor : processor {
+    int id() const override { return 2; }
+  };
+  struct first_key {};
+  struct second_key {};
+
+  container<base_one_test_traits<dense>> container;
+  container.template register_type<scope<shared>, storage<first_processor>,
+                                   interfaces<processor>,
+                                   key_type<first_key>>();
+  container.template register_type<scope<shared>, storage<second_processor>,
+                                   interfaces<processor>,
+                                   key_type<second_key>>();
+
+  EXPECT_EQ(
+      container.template resolve<processor &>(key_type<first_key>{}).id(), 1);
+  EXPECT_EQ(
+      container.template resolve<processor &>(key_type<second_key>{}).id(), 2);
+  EXPECT_THROW(container.template resolve<processor &>(),
+               type_not_found_exception);
+  EXPECT_THROW((container.template register_type<
+                   scope<shared>, storage<first_processor>,
+                   interfaces<processor>, key_type<first_key>>()),
+               lookup_already_registered_exception);
+}
+
+TEST(index_test, base_one_dense_mixes_keyed_and_unkeyed_interfaces) {
+  struct processor {
+    virtual ~processor() = default;
+    virtual int id() const = 0;
+  };
+  struct sink {
+    virtual ~sink() = default;
+    virtual int id() const = 0;
+  };
+  struct unkeyed_processor : processor {
+    int id() const override { return 1; }
+  };
+  struct keyed_processor : processor {
+    int id() const override { return 2; }
+  };
+  struct keyed_sink : sink {
+    int id() const override { return 3; }
+  };
+  struct unkeyed_sink : sink {
+    int id() const override { return 4; }
+  };
+  struct key {};
+
+  container<base_one_test_traits<dense>> container;
+  container.template register_type<scope<shared>, storage<unkeyed_processor>,
+                                   interfaces<processor>>();
+  container.template register_type<scope<shared>, storage<keyed_sink>,
+                                   interfaces<sink>, key_type<key>>();
+  container.template register_type<scope<shared>, storage<keyed_processor>,
+                                   interfaces<processor>, key_type<key>>();
+  container.template register_type<scope<shared>, storage<unkeyed_sink>,
+                                   interfaces<sink>>();
+
+  EXPECT_EQ(container.template resolve<processor &>().id(), 1);
+  EXPECT_EQ(container.template resolve<processor &>(key_type<key>{}).id(), 2);
+  EXPECT_EQ(container.template resolve<sink &>(key_type<key>{}).id(), 3);
+  EXPECT_EQ(container.template resolve<sink &>().id(), 4);
+}
+
+TEST(index_test, base_one_dense_storage_finds_rows_through_const_access) {
+  using test_rtti = rtti<interned_provider>;
+  using key = detail::base_lookup_key<test_rtti>;
+  using storage_type = dense::storage<key, int, one, std::allocator<char>>;
+  struct interface {};
+  struct typed_key {};
+
+  const key unkeyed{test_rtti::get_type_index<interface>(),
+                    test_rtti::get_type_index<none_t>()};
+  const key keyed{test_rtti::get_type_index<interface>(),
+                  test_rtti::get_type_index<typed_key>()};
+
+  std::allocator<char> allocator;
+  storage_type storage(allocator);
+  EXPECT_TRUE(storage.try_emplace(keyed, 2).second);
+  EXPECT_TRUE(storage.try_emplace(unkeyed, 1).second);
+  EXPECT_FALSE(storage.try_emplace(unkeyed, 3).second);
+
+  const auto &view = storage;
+  ASSERT_NE(view.find(unkeyed), view.end());
+  ASSERT_NE(view.find(keyed), view.end());
+  EXPECT_EQ(view.find(unkeyed)->second, 1);
+  EXPECT_EQ(view.find(keyed)->second, 2);
+
+  storage.erase(storage.find(unkeyed));
+  EXPECT_EQ(view.find(unkeyed), view.end());
+  EXPECT_EQ(view.find(keyed)->second, 2);
+
+  int sum = 0;
+  storage.for_each_value([&](int value) { sum += value; });
+  EXPECT_EQ(sum, 2);
+}
+
 TEST(index_test, base_many_ordered_enumerates_implicit_static_keys) {
   expect_base_many_backend_enumerates_implicit_static_keys<ordered>();
 }
@@ -0,0 +1,138 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/static_container.h>
+#include <dingo/storage/shared.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dingo {
+namespace {
+struct dispatch_processor {
+  virtual ~dispatch_processor() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct dispatch_processor_impl : dispatch_processor {
+  int id() const override { return Id; }
+};
+
+template <typename Key, auto Value, int Id = static_cast<int>(Value)>
+using dispatch_binding =
+    bind<scope<shared>, storage<dispatch_processor_impl<Id>>,
+         interfaces<dispatch_processor>, key_type<Key, Value>>;
+
+template <typename Key, typename Cardinality = one>
+struct dispatch_traits : static_container_traits {
+  using lookup_definition_type =
+      lookups<associative<Key, dispatch_processor, Cardinality>>;
+};
+
+enum class dispatch_id : std::int8_t { first = -2, second = 5 };
+
+template <typename Key, auto... Values>
+using dispatch_index = detail::static_key_index<
+    Key, type_list<detail::lookup_key<key_type<Key, Values>>...>>;
+
+static_assert(dispatch_index<std::size_t, 0, 1, 2, 3>::layout.kind ==
+              detail::static_key_table_kind::dense);
+static_assert(dispatch_index<int, -3, 0, 4>::layout.kind ==
+              detail::static_key_table_kind::dense);
+static_assert(dispatch_index<std::size_t, 3, 1000, 77777>::layout.kind ==
+              detail::static_key_table_kind::hashed);
+static_assert(dispatch_index<std::size_t>::size == 0);
+} // namespace
+
+TEST(static_key_dispatch_test, dense_keys_resolve_fixed_bindings) {
+  using source = bindings<dispatch_binding<std::size_t, 0>,
+                          dispatch_binding<std::size_t, 1>,
+                          dispatch_binding<std::size_t, 3>>;
+  static_container<source, dispatch_traits<std::size_t>> container;
+
+  auto &first = container.resolve<dispatch_processor &>(std::size_t(0));
+  EXPECT_EQ(first.id(), 0);
+  using first_dependency =
+      dependency<dispatch_processor &, key_type<std::size_t, 0>>;
+  EXPECT_EQ(&first, &container.resolve<first_dependency>());
+  EXPECT_EQ(container.resolve<dispatch_processor *>(std::size_t(1))->id(), 1);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(std::size_t(3)).id(), 3);
+  EXPECT_THROW(container.resolve<dispatch_processor &>(std::size_t(2)),
+               type_not_found_exception);
+  EXPECT_THROW(container.resolve<dispatch_processor &>(std::size_t(100)),
+               type_not_found_exception);
+}
+
+TEST(static_key_dispatch_test, sparse_keys_use_perfect_hash) {
+  using source = bindings<
+      dispatch_binding<std::uint64_t, 3>, dispatch_binding<std::uint64_t, 1000>,
+      dispatch_binding<std::uint64_t, 77777>,
+      dispatch_binding<std::uint64_t, std::uint64_t{1} << 40, 40>>;
+  static_container<source, dispatch_traits<std::uint64_t>> container;
+
+  EXPECT_EQ(container.resolve<dispatch_processor &>(std::uint64_t(3)).id(), 3);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(std::uint64_t(1000)).id(),
+            1000);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(std::uint64_t(77777)).id(),
+            77777);
+  EXPECT_EQ(
+      container.resolve<dispatch_processor &>(std::uint64_t{1} << 40).id(),
+      40);
+  for (std::uint64_t key : {0, 4, 999, 1001, 77776}) {
+    EXPECT_THROW(container.resolve<dispatch_processor &>(key),
+                 type_not_found_exception);
+  }
+}
+
+TEST(static_key_dispatch_test, enum_and_signed_keys) {
+  using source = bindings<
+      dispatch_binding<dispatch_id, dispatch_id::first, 1>,
+      dispatch_binding<dispatch_id, dispatch_id::second, 2>,
+      dispatch_binding<int, -7>, dispatch_binding<int, 9>>;
+  struct traits : static_container_traits {
+    using lookup_definition_type =
+        lookups<associative<dispatch_id, dispatch_processor>,
+                associative<int, dispatch_processor>>;
+  };
+  static_container<source, traits> container;
+
+  EXPECT_EQ(container.resolve<dispatch_processor &>(dispatch_id::first).id(),
+            1);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(dispatch_id::second).id(),
+            2);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(-7).id(), -7);
+  EXPECT_EQ(container.resolve<dispatch_processor &>(9).id(), 9);
+  EXPECT_THROW(container.resolve<dispatch_processor &>(0),
+               type_not_found_exception);
+}
+
+TEST(static_key_dispatch_test, many_lookup_reports_ambiguous_keys) {
+  using source = bindings<dispatch_binding<std::size_t, 1, 10>,
+                          dispatch_binding<std::size_t, 1, 11>,
+                          dispatch_binding<std::size_t, 2>>;
+  static_container<source, dispatch_traits<std::size_t, many>> container;
+
+  EXPECT_EQ(container.resolve<dispatch_processor &>(std::size_t(2)).id(), 2);
+  EXPECT_THROW(container.resolve<dispatch_processor &>(std::size_t(1)),
+               type_ambiguous_exception);
+}
+
+TEST(static_key_dispatch_test, missing_keys_fall_back_to_parent) {
+  using parent_source = bindings<dispatch_binding<std::size_t, 7>>;
+  using child_source = bindings<dispatch_binding<std::size_t, 1>>;
+  static_container<parent_source, dispatch_traits<std::size_t>> parent;
+  static_container<child_source, decltype(parent)> child(&parent);
+
+  EXPECT_EQ(child.resolve<dispatch_processor &>(std::size_t(1)).id(), 1);
+  EXPECT_EQ(&child.resolve<dispatch_processor &>(std::size_t(7)),
+            &parent.resolve<dispatch_processor &>(std::size_t(7)));
+  EXPECT_THROW(child.resolve<dispatch_processor &>(std::size_t(2)),
+               type_not_found_exception);
+}
+} // namespace dingo
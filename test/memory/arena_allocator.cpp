@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace dingo {
 namespace {
@@ -133,6 +134,24 @@ TEST(arena_allocator_test, checkpoint_rewind_releases_later_overflow_blocks) {
   EXPECT_EQ(counting_allocator_stats::allocations, 1u);
 }
 
+TEST(arena_allocator_test, used_since_counts_bytes_across_overflow_blocks) {
+  std::array<std::uint8_t, 96> buffer{};
+  arena<counting_allocator<std::uint8_t>> arena(buffer, 64);
+
+  static_cast<void>(arena.allocate(16, alignof(std::max_align_t)));
+  auto checkpoint = arena.mark();
+  EXPECT_EQ(arena.used_since(checkpoint), 0u);
+
+  static_cast<void>(arena.allocate(16, alignof(std::max_align_t)));
+  EXPECT_EQ(arena.used_since(checkpoint), 16u);
+
+  static_cast<void>(arena.allocate(256, alignof(std::max_align_t)));
+  EXPECT_GE(arena.used_since(checkpoint), 16u + 256u);
+
+  arena.rewind(checkpoint);
+  EXPECT_EQ(arena.used_since(checkpoint), 0u);
+}
+
 TEST(arena_allocator_test, inline_arena_uses_its_embedded_buffer) {
   inline_arena<128> arena;
 
@@ -191,6 +210,38 @@ TEST(arena_allocator_test, oversized_block_does_not_change_following_size) {
   EXPECT_EQ(counting_allocator_stats::last_allocation_bytes, 128u);
 }
 
+TEST(arena_allocator_test, growing_blocks_double_up_to_the_maximum) {
+  counting_allocator_stats::reset();
+  arena<counting_allocator<std::uint8_t>> arena(
+      arena_growth<128, 512>{}, counting_allocator<std::uint8_t>{});
+
+  std::vector<std::size_t> sizes;
+  while (sizes.size() != 4) {
+    static_cast<void>(arena.allocate(88, alignof(std::max_align_t)));
+    if (counting_allocator_stats::allocations != sizes.size()) {
+      sizes.push_back(counting_allocator_stats::last_allocation_bytes);
+    }
+  }
+
+  EXPECT_EQ(sizes, (std::vector<std::size_t>{128, 256, 512, 512}));
+  EXPECT_EQ(arena.reserved(), counting_allocator_stats::allocated_bytes);
+}
+
+TEST(arena_allocator_test, reserve_requests_one_block) {
+  counting_allocator_stats::reset();
+  arena<counting_allocator<std::uint8_t>> arena(128);
+
+  ASSERT_TRUE(arena.reserve(1000));
+  ASSERT_EQ(counting_allocator_stats::allocations, 1u);
+  ASSERT_TRUE(arena.reserve(1000));
+  for (int i = 0; i != 10; ++i) {
+    static_cast<void>(arena.allocate(80, 16));
+  }
+
+  EXPECT_EQ(counting_allocator_stats::allocations, 1u);
+  EXPECT_GE(arena.reserved(), 1000u);
+}
+
 TEST(arena_allocator_test, allocation_rejects_block_size_overflow) {
   counting_allocator_stats::reset();
   arena<counting_allocator<std::uint8_t>> arena(128);
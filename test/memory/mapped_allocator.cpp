@@ -0,0 +1,104 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/memory/mapped_allocator.h>
+#include <dingo/storage/shared.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace dingo {
+namespace {
+struct mapped_service {
+  mapped_service() : value(7) {}
+  int value;
+};
+} // namespace
+
+TEST(mapped_allocator_test, region_commits_pages_on_demand) {
+  mapped_region region(std::size_t(1) << 20);
+  EXPECT_GE(region.reserved(), std::size_t(1) << 20);
+  EXPECT_EQ(region.committed(), 0u);
+
+  auto *bytes = static_cast<std::uint8_t *>(region.allocate(100, 16));
+  std::memset(bytes, 1, 100);
+
+  EXPECT_GE(region.committed(), 100u);
+  EXPECT_LT(region.committed(), region.reserved());
+}
+
+TEST(mapped_allocator_test, region_reuses_released_top) {
+  mapped_region region(std::size_t(1) << 20);
+
+  auto *first = region.allocate(64, 16);
+  auto *second = region.allocate(64, 16);
+  region.deallocate(second, 64);
+  EXPECT_EQ(region.allocate(64, 16), second);
+
+  region.deallocate(second, 64);
+  region.deallocate(first, 64);
+  EXPECT_EQ(region.allocate(32, 16), first);
+}
+
+TEST(mapped_allocator_test, region_throws_when_exhausted) {
+  mapped_region region(1);
+
+  EXPECT_THROW(region.allocate(region.reserved() + 1, 16), std::bad_alloc);
+  EXPECT_NO_THROW(region.allocate(region.reserved(), 16));
+  EXPECT_THROW(region.allocate(1, 1), std::bad_alloc);
+}
+
+TEST(mapped_allocator_test, huge_page_region_allocates) {
+  mapped_region region(std::size_t(4) << 20, mapped_pages::huge);
+
+  auto *bytes = static_cast<std::uint8_t *>(region.allocate(4096, 64));
+  std::memset(bytes, 1, 4096);
+  EXPECT_EQ(region.page_size(), std::size_t(2) << 20);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bytes) % region.page_size(), 0u);
+  EXPECT_EQ(region.committed() % region.page_size(), 0u);
+}
+
+TEST(mapped_allocator_test, arena_blocks_use_region_pages) {
+  mapped_region region(std::size_t(8) << 20, mapped_pages::huge);
+  arena<mapped_allocator<std::uint8_t>> arena(
+      128, mapped_allocator<std::uint8_t>(region));
+
+  static_cast<void>(
+      arena.allocate(std::size_t(3) << 20, alignof(std::max_align_t)));
+
+  EXPECT_EQ(arena.reserved(), std::size_t(4) << 20);
+}
+
+TEST(mapped_allocator_test, arena_blocks_fill_pages) {
+  mapped_region region(std::size_t(1) << 20);
+  arena<mapped_allocator<std::uint8_t>> arena(
+      128, mapped_allocator<std::uint8_t>(region));
+
+  static_cast<void>(arena.allocate(region.page_size() / 2,
+                                   alignof(std::max_align_t)));
+
+  EXPECT_EQ(arena.reserved(), region.page_size());
+}
+
+TEST(mapped_allocator_test, container_uses_mapped_region) {
+  mapped_region region(std::size_t(16) << 20);
+  mapped_allocator<char> allocator(region);
+  {
+    container<dynamic_container_traits, mapped_allocator<char>> container(
+        allocator);
+    container.register_type<scope<shared>, storage<mapped_service>>();
+
+    EXPECT_EQ(container.resolve<mapped_service &>().value, 7);
+    EXPECT_GT(region.committed(), 0u);
+  }
+}
+} // namespace dingo
@@ -206,14 +206,16 @@ TEST(object_sizes_test, runtime_container_and_lookup_sizes) {
   if constexpr (sizeof(void *) == 8) {
     // Root owners carry the dense table of lazily allocated child lookup
     // states; registration-created children remain two machine words below.
-    expect_size_at_most<container<>>("container<>", 120);
-    expect_size_at_most<size_registry_type>("runtime registry", 112);
+    // Binding states hold one pointer to the tables built by freeze(), and
+    // containers one pointer to the lazily allocated collection view cache.
+    expect_size_at_most<container<>>("container<>", 136);
+    expect_size_at_most<size_registry_type>("runtime registry", 120);
     expect_size_at_most<size_instance_container>(
         "registration container registry", 16);
     expect_size_at_most<size_probe_registry::runtime_bindings_state>(
-        "runtime bindings state", 48);
+        "runtime bindings state", 56);
     expect_size_at_most<size_probe_registry::runtime_scope_state>(
-        "runtime scope state", 56);
+        "runtime scope state", 64);
     expect_size_at_most<
         container_runtime<typename size_registry_type::allocator_type>>(
         "container runtime", 32);
@@ -224,36 +226,48 @@ TEST(object_sizes_test, runtime_container_and_lookup_sizes) {
     expect_size_at_most<runtime_context<std::allocator<char>>>(
         "runtime context", 40);
     expect_size_at_most<size_storage>("shared registration storage", 16);
-    // Stable runtime state keeps its request cache inline; retained source
-    // data lives in the runtime transaction journal instead of a binding-owned
-    // lifetime frame.
-    expect_size_at_most<size_binding_state>("runtime binding state", 48);
-    expect_size_at_most<size_unique_state>("unique runtime binding state", 24);
+    // Runtime state holds the storage and one tagged link to its owner, which
+    // is retagged to an arena record once the binding creates containers;
+    // retained source data lives in the runtime transaction journal.
+    expect_size_at_most<size_binding_state>("runtime binding state", 24);
+    expect_size_at_most<size_unique_state>("unique runtime binding state", 16);
     EXPECT_EQ(sizeof(size_scoped_parent_unique_state),
               sizeof(size_unique_state));
     expect_size_at_most<size_external_state>("external runtime binding state",
-                                             40);
+                                             16);
     expect_size_at_most<size_shared_ptr_state>(
-        "shared_ptr runtime binding state", 56);
+        "shared_ptr runtime binding state", 32);
     expect_size_at_most<size_shared_cyclical_state>(
-        "shared_cyclical runtime binding state", 56);
+        "shared_cyclical runtime binding state", 48);
     expect_size_at_most<size_local_state>(
-        "local-bindings runtime binding state", 48);
+        "local-bindings runtime binding state", 16);
     expect_size_at_most<size_multi_interface_state>(
-        "multi-interface runtime binding state", 56);
+        "multi-interface runtime binding state", 32);
     expect_size_at_most<size_multi_interface_conversion_cache>(
         "pointer-backed conversion cache", 16);
-    // Runtime bindings keep a direct cache-slot pointer beside the vptr so
-    // cache access does not require another virtual dispatch.
-    expect_size_at_most<size_binding>("runtime binding", 64);
+    // Runtime bindings keep their request cache entry inline beside the
+    // resolve thunk, so cache access reads the lookup value directly. A simple
+    // shared binding spends at most four words beyond its storage.
+    expect_size_at_most<size_binding>("runtime binding", 48);
+    EXPECT_LE(sizeof(size_binding) - sizeof(size_storage), 32u);
     expect_size_at_most<size_single_owner>("single-interface binding owner",
-                                           64);
+                                           48);
+    // Each interface of an owner sharing one state caches its own request, so
+    // the owners grow while the shared state they point to shrinks.
     expect_size_at_most<size_multi_interface_pointer_state_owner>(
         "multi-interface pointer-state binding owner", 80);
     expect_size_at_most<size_multi_interface_shared_state_owner>(
         "multi-interface shared-state binding owner", 96);
     expect_size_at_most<size_shared_state_owner>(
-        "single-interface shared-state binding owner", 64);
+        "single-interface shared-state binding owner", 80);
+    EXPECT_LE(sizeof(size_multi_interface_pointer_state_owner) +
+                  sizeof(size_multi_interface_state),
+              112u);
+    EXPECT_LE(sizeof(size_multi_interface_shared_state_owner) +
+                  sizeof(size_multi_interface_state),
+              128u);
+    EXPECT_LE(sizeof(size_shared_state_owner) + sizeof(size_binding_state),
+              104u);
 
     expect_size_at_most<size_probe_registry::runtime_lookup_binding_view>(
         "runtime lookup binding view", 8);
@@ -0,0 +1,180 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime/collection_cache.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct view_processor {
+  virtual ~view_processor() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct view_processor_impl : view_processor {
+  view_processor_impl() {}
+  int id() const override { return Id; }
+};
+
+struct view_key {};
+
+struct view_traits : dynamic_container_traits {
+  using lookup_definition_type = lookups<collection<view_processor>,
+                                         typed<view_key, view_processor, many>>;
+};
+
+// Counts live `void *` arrays, the element storage of cached views.
+template <typename T> struct view_counting_allocator {
+  using value_type = T;
+
+  explicit view_counting_allocator(std::size_t &arrays_ref)
+      : arrays(&arrays_ref) {}
+  template <typename U>
+  view_counting_allocator(const view_counting_allocator<U> &other)
+      : arrays(other.arrays) {}
+
+  T *allocate(std::size_t n) {
+    if constexpr (std::is_same_v<T, void *>) {
+      ++*arrays;
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t n) {
+    if constexpr (std::is_same_v<T, void *>) {
+      --*arrays;
+    }
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template <typename U>
+  bool operator==(const view_counting_allocator<U> &other) const {
+    return arrays == other.arrays;
+  }
+  template <typename U>
+  bool operator!=(const view_counting_allocator<U> &other) const {
+    return arrays != other.arrays;
+  }
+
+  std::size_t *arrays;
+};
+
+std::vector<int> view_ids(collection_view<view_processor *> view) {
+  std::vector<int> ids;
+  for (auto *processor : view) {
+    ids.push_back(processor->id());
+  }
+  return ids;
+}
+} // namespace
+
+TEST(collection_view_test, returns_cached_elements) {
+  container<view_traits> container;
+  container.register_type<scope<shared>, storage<view_processor_impl<1>>,
+                          interfaces<view_processor>>();
+  container.register_type<scope<shared>, storage<view_processor_impl<2>>,
+                          interfaces<view_processor>>();
+
+  auto first = container.view<view_processor *>();
+  auto second = container.view<view_processor *>();
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ(view_ids(first), (std::vector<int>{1, 2}));
+  EXPECT_EQ(std::vector<view_processor *>(first.begin(), first.end()),
+            container.resolve<std::vector<view_processor *>>());
+}
+
+TEST(collection_view_test, registration_invalidates_view) {
+  container<view_traits> container;
+  container.register_type<scope<shared>, storage<view_processor_impl<1>>,
+                          interfaces<view_processor>>();
+  auto first = container.view<view_processor *>();
+  auto *first_processor = first[0];
+
+  container.register_type<scope<shared>, storage<view_processor_impl<2>>,
+                          interfaces<view_processor>>();
+  // An invalidated view stays readable until the collection is rebuilt.
+  EXPECT_EQ(view_ids(first), (std::vector<int>{1}));
+  auto second = container.view<view_processor *>();
+
+  EXPECT_EQ(view_ids(second), (std::vector<int>{1, 2}));
+  EXPECT_EQ(second[0], first_processor);
+}
+
+TEST(collection_view_test, rebuilding_frees_previous_elements) {
+  using cache_type =
+      detail::collection_cache<int, view_counting_allocator<char>>;
+  std::size_t arrays = 0;
+  view_counting_allocator<char> allocator(arrays);
+  view_processor_impl<1> first;
+  view_processor_impl<2> second;
+  {
+    cache_type cache(allocator);
+    std::vector<view_processor *> values{&first};
+    for (int i = 0; i < 3; ++i) {
+      cache.invalidate();
+      values.push_back(&second);
+      auto view = cache.store<view_processor *>(0, cache.generation(), values);
+      EXPECT_EQ(view.size(), values.size());
+      EXPECT_EQ(arrays, 1u);
+    }
+    cache.store<view_processor *>(1, cache.generation(), values);
+    EXPECT_EQ(arrays, 2u);
+
+    collection_view<view_processor *> found;
+    EXPECT_TRUE(cache.find(0, cache.generation(), found));
+    EXPECT_EQ(view_ids(found), (std::vector<int>{1, 2, 2, 2}));
+    cache.invalidate();
+    EXPECT_FALSE(cache.find(0, cache.generation(), found));
+  }
+  EXPECT_EQ(arrays, 0u);
+}
+
+TEST(collection_view_test, keys_views_by_type_key) {
+  container<view_traits> container;
+  container.register_type<scope<shared>, storage<view_processor_impl<1>>,
+                          interfaces<view_processor>>();
+  container.register_type<scope<shared>, storage<view_processor_impl<2>>,
+                          interfaces<view_processor>, key_type<view_key>>();
+
+  EXPECT_EQ(view_ids(container.view<view_processor *>()),
+            (std::vector<int>{1}));
+  EXPECT_EQ(view_ids(container.view<view_processor *>(key_type<view_key>{})),
+            (std::vector<int>{2}));
+}
+
+TEST(collection_view_test, rejects_unstable_storage) {
+  container<view_traits> container;
+  container.register_type<scope<unique>, storage<view_processor_impl<1> *>,
+                          interfaces<view_processor>>();
+
+  EXPECT_THROW(container.view<view_processor *>(),
+               type_not_convertible_exception);
+}
+
+TEST(collection_view_test, parent_registration_invalidates_child_view) {
+  container<view_traits> parent;
+  parent.register_type<scope<shared>, storage<view_processor_impl<1>>,
+                       interfaces<view_processor>>();
+  container<view_traits, std::allocator<char>, container<view_traits>> child(
+      &parent);
+
+  EXPECT_EQ(view_ids(child.view<view_processor *>()), (std::vector<int>{1}));
+  parent.register_type<scope<shared>, storage<view_processor_impl<2>>,
+                       interfaces<view_processor>>();
+  EXPECT_EQ(view_ids(child.view<view_processor *>()),
+            (std::vector<int>{1, 2}));
+}
+} // namespace dingo
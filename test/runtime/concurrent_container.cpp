@@ -0,0 +1,305 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime/concurrency.h>
+#include <dingo/storage/external.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct concurrent_traits : dynamic_container_traits {
+  using concurrency_type = concurrent;
+};
+
+struct concurrent_dependency {
+  concurrent_dependency() { ++constructions; }
+
+  static std::atomic<int> constructions;
+};
+
+std::atomic<int> concurrent_dependency::constructions{0};
+
+struct concurrent_service_interface {
+  virtual ~concurrent_service_interface() = default;
+};
+
+struct concurrent_service : concurrent_service_interface {
+  explicit concurrent_service(concurrent_dependency &dependency_ref)
+      : dependency(dependency_ref) {
+    ++constructions;
+  }
+
+  concurrent_dependency &dependency;
+  static std::atomic<int> constructions;
+};
+
+std::atomic<int> concurrent_service::constructions{0};
+
+template <std::size_t> struct concurrent_registered {};
+
+// Holds the container lock from its constructor until released.
+struct concurrent_blocker {
+  concurrent_blocker() {
+    entered->set_value();
+    released->wait();
+  }
+
+  static std::promise<void> *entered;
+  static std::shared_future<void> *released;
+};
+
+std::promise<void> *concurrent_blocker::entered = nullptr;
+std::shared_future<void> *concurrent_blocker::released = nullptr;
+
+std::size_t counted_allocations = 0;
+
+// Counts the allocations made through all of its rebound copies.
+template <typename T> struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator() = default;
+  template <typename U> counting_allocator(const counting_allocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    ++counted_allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  template <typename U> bool operator==(const counting_allocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const counting_allocator<U> &) const {
+    return false;
+  }
+};
+
+template <typename Fn> void run_threads(std::size_t count, Fn &&fn) {
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < count; ++i) {
+    threads.emplace_back([&, i] {
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      fn(i);
+    });
+  }
+  start.store(true, std::memory_order_release);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+static_assert(std::is_same_v<
+              detail::container_concurrency_type_t<dynamic_container_traits>,
+              single_threaded>);
+static_assert(
+    std::is_same_v<detail::container_concurrency_type_t<concurrent_traits>,
+                   concurrent>);
+} // namespace
+
+TEST(concurrent_container_test, shared_bindings_resolve_from_many_threads) {
+  concurrent_dependency::constructions = 0;
+  concurrent_service::constructions = 0;
+
+  container<concurrent_traits> container;
+  container.register_type<scope<shared>, storage<concurrent_dependency>>();
+  container.register_type<scope<shared>, storage<concurrent_service>,
+                          interfaces<concurrent_service_interface>>();
+
+  constexpr std::size_t thread_count = 8;
+  std::vector<concurrent_service_interface *> results(thread_count);
+  run_threads(thread_count, [&](std::size_t index) {
+    for (int i = 0; i < 1000; ++i) {
+      results[index] = &container.resolve<concurrent_service_interface &>();
+    }
+  });
+
+  for (auto *result : results) {
+    EXPECT_EQ(result, results.front());
+  }
+  EXPECT_EQ(concurrent_dependency::constructions, 1);
+  EXPECT_EQ(concurrent_service::constructions, 1);
+}
+
+TEST(concurrent_container_test, unique_bindings_resolve_from_many_threads) {
+  container<concurrent_traits> container;
+  container.register_type<scope<external>, storage<int>>(7);
+  container.register_type<scope<unique>, storage<std::unique_ptr<long>>>();
+
+  std::atomic<int> failures{0};
+  run_threads(4, [&](std::size_t) {
+    for (int i = 0; i < 1000; ++i) {
+      if (container.resolve<int &>() != 7 ||
+          container.resolve<std::unique_ptr<long>>() == nullptr) {
+        ++failures;
+      }
+    }
+  });
+  EXPECT_EQ(failures, 0);
+}
+
+TEST(concurrent_container_test, registration_invalidates_published_resolution) {
+  struct traits : concurrent_traits {
+    using lookup_definition_type =
+        lookups<collection<concurrent_service_interface>>;
+  };
+
+  container<traits> container;
+  container.register_type<scope<shared>, storage<concurrent_dependency>>();
+  container.register_type<scope<shared>, storage<concurrent_service>,
+                          interfaces<concurrent_service_interface>>();
+  auto &first = container.resolve<concurrent_service_interface &>();
+  EXPECT_EQ(&container.resolve<concurrent_service_interface &>(), &first);
+
+  struct other_service : concurrent_service_interface {};
+  container.register_type<scope<shared>, storage<other_service>,
+                          interfaces<concurrent_service_interface>>();
+  EXPECT_THROW(container.resolve<concurrent_service_interface &>(),
+               type_ambiguous_exception);
+}
+
+TEST(concurrent_container_test, resolve_all_publishes_resolutions) {
+  container<concurrent_traits> container;
+  container.register_type<scope<shared>, storage<concurrent_dependency>>();
+  container.register_type<scope<shared>, storage<concurrent_service>,
+                          interfaces<concurrent_service_interface>>();
+  container.register_type<scope<shared>, storage<concurrent_blocker>>();
+  auto [service] = container.resolve_all<concurrent_service_interface &>();
+
+  std::promise<void> entered;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  concurrent_blocker::entered = &entered;
+  concurrent_blocker::released = &released;
+  std::thread holder([&] { container.resolve<concurrent_blocker &>(); });
+  entered.get_future().wait();
+
+  // The holder owns the container lock, so only a published resolution can
+  // complete before it is released.
+  auto reader = std::async(std::launch::async, [&] {
+    return &container.resolve<concurrent_service_interface &>();
+  });
+  const auto status = reader.wait_for(std::chrono::seconds(10));
+  release.set_value();
+  holder.join();
+  EXPECT_EQ(status, std::future_status::ready);
+  EXPECT_EQ(reader.get(), &service);
+}
+
+TEST(concurrent_container_test, snapshot_reuses_table_after_invalidation) {
+  detail::resolution_snapshot<concurrent, counting_allocator<char>> snapshot{
+      counting_allocator<char>()};
+  int keys[3] = {};
+  int values[3] = {};
+  void *address = nullptr;
+  auto lock = snapshot.lock();
+  for (auto &key : keys) {
+    snapshot.publish(&key, &values[&key - keys]);
+  }
+  const auto allocations = counted_allocations;
+
+  for (int i = 0; i < 1000; ++i) {
+    snapshot.invalidate();
+    EXPECT_FALSE(snapshot.find(&keys[0], address));
+    for (auto &key : keys) {
+      snapshot.publish(&key, &values[&key - keys]);
+    }
+  }
+  EXPECT_EQ(counted_allocations, allocations);
+  ASSERT_TRUE(snapshot.find(&keys[2], address));
+  EXPECT_EQ(address, &values[2]);
+}
+
+// Starts `fn` while the holder owns the lock of `container` and reports
+// whether it waited for the holder to release it.
+template <typename Container, typename Fn>
+bool waits_for_lock(Container &container, Fn &&fn) {
+  std::promise<void> entered;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  concurrent_blocker::entered = &entered;
+  concurrent_blocker::released = &released;
+  std::thread holder([&] { container.template resolve<concurrent_blocker>(); });
+  entered.get_future().wait();
+
+  auto waiter = std::async(std::launch::async, std::forward<Fn>(fn));
+  const auto status = waiter.wait_for(std::chrono::milliseconds(50));
+  release.set_value();
+  holder.join();
+  waiter.get();
+  return status == std::future_status::timeout;
+}
+
+TEST(concurrent_container_test, registration_containers_take_root_lock) {
+  container<concurrent_traits> container;
+  auto service =
+      container.register_type<scope<shared>, storage<concurrent_service>,
+                              interfaces<concurrent_service_interface>>();
+  container.register_type<scope<unique>, storage<concurrent_blocker>>();
+
+  EXPECT_TRUE(waits_for_lock(container, [&] {
+    service->register_type<scope<shared>, storage<concurrent_dependency>>();
+  }));
+  EXPECT_NO_THROW(container.resolve<concurrent_service_interface &>());
+}
+
+TEST(concurrent_container_test, parent_fallback_takes_parent_lock) {
+  using parent_type = container<concurrent_traits>;
+  parent_type parent;
+  parent.register_type<scope<shared>, storage<concurrent_dependency>>();
+  parent.register_type<scope<unique>, storage<concurrent_blocker>>();
+  container<concurrent_traits, std::allocator<char>, parent_type> child(
+      &parent);
+  child.register_type<scope<unique>, storage<concurrent_service>>();
+
+  EXPECT_TRUE(
+      waits_for_lock(parent, [&] { child.resolve<concurrent_service>(); }));
+  EXPECT_EQ(&child.resolve<concurrent_service>().dependency,
+            &parent.resolve<concurrent_dependency &>());
+}
+
+TEST(concurrent_container_test, registrations_run_concurrently_with_readers) {
+  container<concurrent_traits> container;
+  container.register_type<scope<shared>, storage<concurrent_dependency>>();
+  auto *expected = &container.resolve<concurrent_dependency &>();
+
+  std::atomic<int> failures{0};
+  run_threads(4, [&](std::size_t index) {
+    if (index == 0) {
+      container.register_type<scope<shared>,
+                              storage<concurrent_registered<0>>>();
+      container.register_type<scope<shared>,
+                              storage<concurrent_registered<1>>>();
+      container.register_type<scope<shared>,
+                              storage<concurrent_registered<2>>>();
+      container.resolve<concurrent_registered<1> &>();
+    } else {
+      for (int i = 0; i < 1000; ++i) {
+        if (&container.resolve<concurrent_dependency &>() != expected) {
+          ++failures;
+        }
+      }
+    }
+  });
+  EXPECT_EQ(failures, 0);
+  EXPECT_EQ(&container.resolve<concurrent_registered<0> &>(),
+            &container.resolve<concurrent_registered<0> &>());
+}
+} // namespace dingo
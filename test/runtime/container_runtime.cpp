@@ -6,10 +6,15 @@
 //
 
 #include <dingo/runtime/container_runtime.h>
+#include <dingo/runtime/statistics.h>
+#include <dingo/runtime_container.h>
+#include <dingo/storage/unique.h>
 
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dingo {
@@ -25,6 +30,29 @@ struct runtime_arena_tracker {
   int value_;
 };
 
+template <std::size_t> struct reserved_service {};
+
+struct reserve_traits : dynamic_container_traits {
+  using statistics_type = collect_statistics;
+  using arena_growth_type = arena_growth<128, 1024>;
+};
+
+template <std::size_t... Indices>
+void register_reserved_services(runtime_container<reserve_traits> &container,
+                                std::index_sequence<Indices...>) {
+  (container.register_type<scope<unique>, storage<reserved_service<Indices>>>(),
+   ...);
+}
+
+static_assert(
+    std::is_same_v<
+        detail::container_arena_growth_type_t<dynamic_container_traits>,
+        arena_growth<DINGO_RUNTIME_ARENA_BLOCK_SIZE,
+                     DINGO_RUNTIME_ARENA_MAX_BLOCK_SIZE>>);
+static_assert(
+    std::is_same_v<detail::container_arena_growth_type_t<reserve_traits>,
+                   arena_growth<128, 1024>>);
+
 struct object_store_destroy_observer {
   object_store_destroy_observer(std::vector<int> *events, int *observed)
       : events_(events), observed_(observed) {}
@@ -124,5 +152,18 @@ TEST(container_runtime_test,
   }
 }
 
+TEST(container_runtime_test, reserve_bindings_avoids_arena_growth) {
+  runtime_container<reserve_traits> container;
+  container.reserve_bindings(16);
+  auto reserved = container.statistics().arena_reserved;
+  EXPECT_GE(reserved, 16u * DINGO_RUNTIME_BINDING_RESERVE_SIZE);
+
+  register_reserved_services(container, std::make_index_sequence<16>());
+
+  auto statistics = container.statistics();
+  EXPECT_EQ(statistics.bindings, 16u);
+  EXPECT_EQ(statistics.arena_reserved, reserved);
+}
+
 } // namespace
 } // namespace dingo
@@ -0,0 +1,122 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct frozen_logger {};
+
+struct frozen_service {
+  explicit frozen_service(frozen_logger &logger_ref) : logger(logger_ref) {}
+
+  frozen_logger &logger;
+};
+
+struct frozen_handler {
+  virtual ~frozen_handler() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct frozen_handler_impl : frozen_handler {
+  int id() const override { return Id; }
+};
+
+struct frozen_listener {
+  virtual ~frozen_listener() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct frozen_listener_impl : frozen_listener {
+  int id() const override { return Id; }
+};
+
+struct frozen_keyed_traits : dynamic_container_traits {
+  using lookup_definition_type =
+      lookups<associative<int, frozen_handler>,
+              associative<std::size_t, frozen_listener, many, unordered>>;
+};
+} // namespace
+
+TEST(freeze_test, resolves_after_freeze) {
+  container<> container;
+  container.register_type<scope<shared>, storage<frozen_logger>>();
+  container.register_type<scope<unique>, storage<frozen_service>>();
+  auto &logger = container.resolve<frozen_logger &>();
+
+  EXPECT_FALSE(container.frozen());
+  container.freeze();
+  container.freeze();
+  EXPECT_TRUE(container.frozen());
+
+  EXPECT_EQ(&container.resolve<frozen_logger &>(), &logger);
+  EXPECT_EQ(&container.resolve<frozen_service>().logger, &logger);
+}
+
+TEST(freeze_test, rejects_registrations) {
+  container<> container;
+  container.register_type<scope<shared>, storage<frozen_logger>>();
+  container.freeze();
+
+  EXPECT_THROW((container.register_type<scope<unique>,
+                                        storage<frozen_service>>()),
+               container_frozen_exception);
+  EXPECT_NO_THROW(container.resolve<frozen_logger &>());
+  EXPECT_THROW(container.resolve<frozen_service>(), type_not_found_exception);
+}
+
+TEST(freeze_test, rejects_registrations_into_registration_containers) {
+  container<> container;
+  auto service =
+      container.register_type<scope<unique>, storage<frozen_service>>();
+  container.freeze();
+
+  EXPECT_THROW(
+      (service->register_type<scope<shared>, storage<frozen_logger>>()),
+      container_frozen_exception);
+  EXPECT_THROW(container.resolve<frozen_service>(), type_not_found_exception);
+}
+
+TEST(freeze_test, resolves_keyed_lookups_after_freeze) {
+  container<frozen_keyed_traits> container;
+  container.register_type<scope<shared>, storage<frozen_handler_impl<1>>,
+                          interfaces<frozen_handler>>(key_value{1});
+  container.register_type<scope<shared>, storage<frozen_handler_impl<2>>,
+                          interfaces<frozen_handler>>(key_value{2});
+  container.register_type<scope<shared>, storage<frozen_listener_impl<3>>,
+                          interfaces<frozen_listener>>(
+      key_value{std::size_t(7)});
+  container.register_type<scope<shared>, storage<frozen_listener_impl<4>>,
+                          interfaces<frozen_listener>>(
+      key_value{std::size_t(7)});
+  container.freeze();
+
+  EXPECT_EQ(container.resolve<frozen_handler &>(1).id(), 1);
+  EXPECT_EQ(container.resolve<frozen_handler &>(2).id(), 2);
+  EXPECT_THROW(container.resolve<frozen_handler &>(3),
+               type_not_found_exception);
+
+  auto listeners =
+      container.resolve<std::vector<frozen_listener *>>(std::size_t(7));
+  std::vector<int> ids;
+  for (auto *listener : listeners) {
+    ids.push_back(listener->id());
+  }
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(ids, (std::vector<int>{3, 4}));
+  EXPECT_THROW(container.resolve<frozen_listener &>(std::size_t(7)),
+               type_ambiguous_exception);
+}
+} // namespace dingo
@@ -0,0 +1,165 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+namespace {
+int lazy_constructed = 0;
+
+struct lazy_processor {
+  virtual ~lazy_processor() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct lazy_processor_impl : lazy_processor {
+  lazy_processor_impl() { ++lazy_constructed; }
+  int id() const override { return Id; }
+};
+
+struct lazy_traits : dynamic_container_traits {
+  using lookup_definition_type = lookups<collection<lazy_processor>>;
+};
+
+struct lazy_missing {
+  virtual ~lazy_missing() = default;
+};
+
+// Counts live `void *` arrays, which is how member bindings are stored.
+std::ptrdiff_t lazy_binding_arrays = 0;
+
+template <typename T> struct lazy_counting_allocator {
+  using value_type = T;
+
+  lazy_counting_allocator() = default;
+  template <typename U>
+  lazy_counting_allocator(const lazy_counting_allocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    if constexpr (std::is_same_v<T, void *>) {
+      ++lazy_binding_arrays;
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t n) {
+    if constexpr (std::is_same_v<T, void *>) {
+      --lazy_binding_arrays;
+    }
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template <typename U>
+  bool operator==(const lazy_counting_allocator<U> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const lazy_counting_allocator<U> &) const {
+    return false;
+  }
+};
+} // namespace
+
+TEST(lazy_collection_test, constructs_members_on_dereference) {
+  lazy_constructed = 0;
+  container<lazy_traits> container;
+  container.register_type<scope<shared>, storage<lazy_processor_impl<1>>,
+                          interfaces<lazy_processor>>();
+  container.register_type<scope<shared>, storage<lazy_processor_impl<2>>,
+                          interfaces<lazy_processor>>();
+  container.register_type<scope<shared>, storage<lazy_processor_impl<3>>,
+                          interfaces<lazy_processor>>();
+
+  auto processors = container.resolve<lazy_collection<lazy_processor *>>();
+  ASSERT_EQ(processors.size(), 3U);
+  EXPECT_EQ(lazy_constructed, 0);
+
+  auto it = std::find_if(processors.begin(), processors.end(),
+                         [](lazy_processor *value) { return value->id(); });
+  ASSERT_NE(it, processors.end());
+  EXPECT_EQ((*it)->id(), 1);
+  EXPECT_EQ(lazy_constructed, 1);
+
+  std::vector<int> ids;
+  for (auto *processor : processors) {
+    ids.push_back(processor->id());
+  }
+  EXPECT_EQ(ids, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(lazy_constructed, 3);
+  EXPECT_EQ(processors[1],
+            container.resolve<std::vector<lazy_processor *>>()[1]);
+}
+
+TEST(lazy_collection_test, resolves_unique_members_per_dereference) {
+  container<lazy_traits> container;
+  container.register_type<scope<unique>,
+                          storage<std::unique_ptr<lazy_processor_impl<1>>>,
+                          interfaces<lazy_processor>>();
+
+  auto processors =
+      container.resolve<lazy_collection<std::unique_ptr<lazy_processor>>>();
+  ASSERT_EQ(processors.size(), 1U);
+  auto first = processors[0];
+  auto second = processors[0];
+  EXPECT_EQ(first->id(), 1);
+  EXPECT_NE(first.get(), second.get());
+}
+
+TEST(lazy_collection_test, falls_back_to_parent) {
+  container<lazy_traits> parent;
+  parent.register_type<scope<shared>, storage<lazy_processor_impl<1>>,
+                       interfaces<lazy_processor>>();
+  container<lazy_traits, std::allocator<char>, container<lazy_traits>> child(
+      &parent);
+
+  auto processors = child.resolve<lazy_collection<lazy_processor *>>();
+  ASSERT_EQ(processors.size(), 1U);
+  EXPECT_EQ(processors[0], &parent.resolve<lazy_processor &>());
+}
+
+TEST(lazy_collection_test, handles_missing_members) {
+  container<lazy_traits> container;
+  EXPECT_TRUE(container.resolve<lazy_collection<lazy_processor *>>().empty());
+  EXPECT_THROW(container.resolve<lazy_collection<lazy_missing *>>(),
+               type_not_found_exception);
+}
+TEST(lazy_collection_test, uses_container_allocator) {
+  std::ptrdiff_t before = 0;
+  lazy_collection<lazy_processor *> copy;
+  {
+    container<lazy_traits, lazy_counting_allocator<char>> container;
+    container.register_type<scope<shared>, storage<lazy_processor_impl<1>>,
+                            interfaces<lazy_processor>>();
+    container.register_type<scope<shared>, storage<lazy_processor_impl<2>>,
+                            interfaces<lazy_processor>>();
+    before = lazy_binding_arrays;
+
+    auto processors = container.resolve<lazy_collection<lazy_processor *>>();
+    EXPECT_EQ(lazy_binding_arrays, before + 1);
+    copy = processors;
+    EXPECT_EQ(lazy_binding_arrays, before + 2);
+    ASSERT_EQ(copy.size(), 2U);
+    EXPECT_EQ(copy[1]->id(), 2);
+    EXPECT_EQ(processors[1], copy[1]);
+  }
+  // A range may be copied and destroyed once its container is gone.
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.size(), 2U);
+  moved = lazy_collection<lazy_processor *>();
+  EXPECT_EQ(lazy_binding_arrays, 0);
+}
+} // namespace dingo
@@ -0,0 +1,168 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime/observer.h>
+#include <dingo/runtime_container.h>
+#include <dingo/storage/external.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace dingo {
+namespace {
+enum class observed_kind { begin, end, cache_hit, construct };
+
+struct observed_event {
+  observed_kind kind;
+  type_descriptor type;
+};
+
+struct recording_observer : resolution_observer {
+  static inline std::vector<observed_event> events;
+
+  static void on_resolve_begin(type_descriptor type) {
+    events.push_back({observed_kind::begin, type});
+  }
+
+  static void on_resolve_end(type_descriptor type,
+                             std::chrono::nanoseconds duration) {
+    EXPECT_GE(duration.count(), 0);
+    events.push_back({observed_kind::end, type});
+  }
+
+  static void on_cache_hit(type_descriptor type) {
+    events.push_back({observed_kind::cache_hit, type});
+  }
+
+  static void on_construct(type_descriptor type,
+                           std::chrono::nanoseconds duration) {
+    EXPECT_GE(duration.count(), 0);
+    events.push_back({observed_kind::construct, type});
+  }
+};
+
+// Overrides only the hooks it needs.
+struct construct_observer : resolution_observer {
+  static inline int constructed = 0;
+
+  static void on_construct(type_descriptor, std::chrono::nanoseconds) {
+    ++constructed;
+  }
+};
+
+struct observed_traits : dynamic_container_traits {
+  using observer_type = recording_observer;
+};
+
+struct construct_observed_traits : dynamic_container_traits {
+  using observer_type = construct_observer;
+};
+
+struct observed_logger {};
+
+struct observed_service {
+  explicit observed_service(observed_logger &) {}
+};
+
+struct observed_failing {
+  observed_failing() { throw std::runtime_error("failure"); }
+};
+
+struct observer_test : testing::Test {
+  void SetUp() override { recording_observer::events.clear(); }
+
+  static std::vector<observed_event> events(observed_kind kind) {
+    std::vector<observed_event> result;
+    for (const auto &event : recording_observer::events) {
+      if (event.kind == kind) {
+        result.push_back(event);
+      }
+    }
+    return result;
+  }
+};
+
+static_assert(
+    std::is_same_v<detail::container_observer_type_t<dynamic_container_traits>,
+                   void>);
+} // namespace
+
+TEST_F(observer_test, reports_resolution_and_construction) {
+  runtime_container<observed_traits> container;
+  container.register_type<scope<shared>, storage<observed_service>>();
+  container.register_type<scope<shared>, storage<observed_logger>>();
+
+  container.resolve<observed_service &>();
+
+  auto &events = recording_observer::events;
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events[0].kind, observed_kind::begin);
+  EXPECT_EQ(events[0].type, describe_type<observed_service &>());
+  // The dependency finishes first and the service includes it.
+  EXPECT_EQ(events[1].kind, observed_kind::construct);
+  EXPECT_EQ(events[1].type, describe_type<observed_logger>());
+  EXPECT_EQ(events[2].kind, observed_kind::construct);
+  EXPECT_EQ(events[2].type, describe_type<observed_service>());
+  EXPECT_EQ(events[3].kind, observed_kind::end);
+  EXPECT_EQ(events[3].type, describe_type<observed_service &>());
+}
+
+TEST_F(observer_test, reports_cache_hits) {
+  container<observed_traits> container;
+  container.register_type<scope<shared>, storage<observed_logger>>();
+
+  container.resolve<observed_logger &>();
+  recording_observer::events.clear();
+  container.resolve<observed_logger &>();
+
+  auto hits = events(observed_kind::cache_hit);
+  ASSERT_EQ(hits.size(), 1u);
+  EXPECT_EQ(hits[0].type, describe_type<observed_logger &>());
+  EXPECT_TRUE(events(observed_kind::construct).empty());
+  EXPECT_EQ(events(observed_kind::end).size(), 1u);
+}
+
+TEST_F(observer_test, skips_bindings_without_construction) {
+  runtime_container<observed_traits> container;
+  observed_logger logger;
+  container.register_type<scope<external>, storage<observed_logger &>>(
+      logger);
+  container.register_type<scope<unique>, storage<observed_service>>();
+
+  container.resolve<observed_service>();
+  container.resolve<observed_service>();
+
+  auto constructed = events(observed_kind::construct);
+  ASSERT_EQ(constructed.size(), 2u);
+  EXPECT_EQ(constructed[0].type, describe_type<observed_service>());
+  EXPECT_EQ(constructed[1].type, describe_type<observed_service>());
+}
+
+TEST_F(observer_test, ends_failed_resolution) {
+  runtime_container<observed_traits> container;
+  container.register_type<scope<shared>, storage<observed_failing>>();
+
+  EXPECT_THROW(container.resolve<observed_failing &>(), std::runtime_error);
+  EXPECT_EQ(events(observed_kind::begin).size(), 1u);
+  EXPECT_EQ(events(observed_kind::end).size(), 1u);
+  EXPECT_TRUE(events(observed_kind::construct).empty());
+}
+
+TEST_F(observer_test, observer_overrides_some_hooks) {
+  container<construct_observed_traits> container;
+  container.register_type<scope<unique>, storage<observed_logger>>();
+
+  container.resolve<observed_logger>();
+  EXPECT_EQ(construct_observer::constructed, 1);
+}
+} // namespace dingo
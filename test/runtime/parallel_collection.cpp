@@ -0,0 +1,207 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace dingo {
+namespace {
+std::atomic<int> parallel_configs{0};
+std::atomic<int> parallel_handlers{0};
+
+struct parallel_config {
+  parallel_config() { ++parallel_configs; }
+  ~parallel_config() { --parallel_configs; }
+};
+
+struct parallel_handler {
+  virtual ~parallel_handler() = default;
+  virtual int id() const = 0;
+};
+
+template <int Id> struct parallel_handler_impl : parallel_handler {
+  explicit parallel_handler_impl(parallel_config &) { ++parallel_handlers; }
+  ~parallel_handler_impl() override { --parallel_handlers; }
+  int id() const override { return Id; }
+};
+
+struct parallel_failing_handler : parallel_handler {
+  explicit parallel_failing_handler(parallel_config &) {
+    throw std::runtime_error("parallel_failing_handler");
+  }
+  int id() const override { return -1; }
+};
+
+// Lets a constructor wait until every member constructor has started.
+struct parallel_rendezvous {
+  std::mutex mutex;
+  std::condition_variable arrived;
+  int expected = 0;
+  int count = 0;
+
+  bool meet() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++count;
+    arrived.notify_all();
+    return arrived.wait_for(lock, std::chrono::seconds(10),
+                            [this] { return count >= expected; });
+  }
+};
+
+parallel_rendezvous *rendezvous = nullptr;
+std::atomic<int> rendezvous_met{0};
+
+template <int Id> struct parallel_waiting_handler : parallel_handler {
+  explicit parallel_waiting_handler(parallel_config &) {
+    if (rendezvous->meet()) {
+      ++rendezvous_met;
+    }
+  }
+  int id() const override { return Id; }
+};
+
+std::atomic<int> parallel_owned_members{0};
+
+// Records whether its thread is marked as constructing a member, which is
+// what makes a call back into the container assert.
+struct parallel_owned_handler : parallel_handler {
+  explicit parallel_owned_handler(parallel_config &) {
+    if (detail::parallel_member_owner() != nullptr) {
+      ++parallel_owned_members;
+    }
+  }
+  int id() const override { return 0; }
+};
+
+struct parallel_traits : dynamic_container_traits {
+  using lookup_definition_type = lookups<collection<parallel_handler>>;
+};
+
+struct thread_executor {
+  std::vector<std::thread> threads;
+
+  template <typename Task> void operator()(Task task) {
+    threads.emplace_back(task);
+  }
+
+  ~thread_executor() {
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
+
+template <typename Handler>
+void register_handler(container<parallel_traits> &container) {
+  container.register_type<scope<unique>,
+                          storage<std::unique_ptr<Handler>>,
+                          interfaces<parallel_handler>>();
+}
+
+using handler_vector = std::vector<std::unique_ptr<parallel_handler>>;
+} // namespace
+
+TEST(parallel_collection_test, keeps_registration_order) {
+  container<parallel_traits> container;
+  container.register_type<scope<shared>, storage<parallel_config>>();
+  register_handler<parallel_handler_impl<0>>(container);
+  register_handler<parallel_handler_impl<1>>(container);
+  register_handler<parallel_handler_impl<2>>(container);
+  register_handler<parallel_handler_impl<3>>(container);
+
+  thread_executor executor;
+  auto handlers =
+      container.construct_collection_parallel<handler_vector>(executor);
+  ASSERT_EQ(handlers.size(), 4U);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(handlers[static_cast<std::size_t>(i)]->id(), i);
+  }
+  EXPECT_EQ(parallel_configs, 1);
+}
+
+TEST(parallel_collection_test, runs_constructors_concurrently) {
+  parallel_rendezvous meeting;
+  meeting.expected = 3;
+  rendezvous = &meeting;
+  rendezvous_met = 0;
+
+  container<parallel_traits> container;
+  container.register_type<scope<shared>, storage<parallel_config>>();
+  register_handler<parallel_waiting_handler<0>>(container);
+  register_handler<parallel_waiting_handler<1>>(container);
+  register_handler<parallel_waiting_handler<2>>(container);
+
+  {
+    thread_executor executor;
+    auto handlers =
+        container.construct_collection_parallel<handler_vector>(executor);
+    ASSERT_EQ(handlers.size(), 3U);
+  }
+  EXPECT_EQ(rendezvous_met, 3);
+  rendezvous = nullptr;
+}
+
+TEST(parallel_collection_test, rolls_back_all_members_on_failure) {
+  {
+    container<parallel_traits> container;
+    container.register_type<scope<shared>, storage<parallel_config>>();
+    register_handler<parallel_handler_impl<0>>(container);
+    register_handler<parallel_failing_handler>(container);
+    register_handler<parallel_handler_impl<2>>(container);
+
+    thread_executor executor;
+    EXPECT_THROW(
+        container.construct_collection_parallel<handler_vector>(executor),
+        std::runtime_error);
+    EXPECT_EQ(parallel_handlers, 0);
+    EXPECT_EQ(parallel_configs, 0);
+  }
+  EXPECT_EQ(parallel_configs, 0);
+}
+
+TEST(parallel_collection_test, accepts_inline_executor) {
+  container<parallel_traits> container;
+  container.register_type<scope<shared>, storage<parallel_config>>();
+  register_handler<parallel_handler_impl<0>>(container);
+  register_handler<parallel_handler_impl<1>>(container);
+
+  auto handlers = container.construct_collection_parallel<handler_vector>(
+      [](auto task) { task(); });
+  ASSERT_EQ(handlers.size(), 2U);
+  EXPECT_EQ(handlers[0]->id(), 0);
+  EXPECT_EQ(handlers[1]->id(), 1);
+}
+TEST(parallel_collection_test, marks_member_threads) {
+  parallel_owned_members = 0;
+  container<parallel_traits> container;
+  container.register_type<scope<shared>, storage<parallel_config>>();
+  register_handler<parallel_owned_handler>(container);
+  register_handler<parallel_owned_handler>(container);
+
+  {
+    thread_executor executor;
+    container.construct_collection_parallel<handler_vector>(executor);
+  }
+  container.construct_collection_parallel<handler_vector>(
+      [](auto task) { task(); });
+  EXPECT_EQ(parallel_owned_members, 4);
+  EXPECT_EQ(detail::parallel_member_owner(), nullptr);
+  EXPECT_NO_THROW(container.resolve<parallel_config &>());
+}
+} // namespace dingo
@@ -0,0 +1,177 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/factory/callable.h>
+#include <dingo/runtime/session.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace dingo {
+namespace {
+struct session_payload {
+  session_payload() { addresses.push_back(this); }
+
+  char data[1024] = {};
+  static std::vector<const void *> addresses;
+};
+
+std::vector<const void *> session_payload::addresses;
+
+struct session_consumer {
+  explicit session_consumer(const session_payload &payload)
+      : size(sizeof(payload.data)) {}
+
+  std::size_t size;
+};
+
+struct session_throwing {
+  session_throwing() { throw std::runtime_error("session_throwing"); }
+};
+
+struct session_throwing_consumer {
+  session_throwing_consumer(const session_payload &, session_throwing &) {}
+};
+
+template <int Id> struct session_counted {
+  session_counted() { ++constructions; }
+
+  static int constructions;
+};
+
+template <int Id> int session_counted<Id>::constructions = 0;
+
+struct session_throwing_product {};
+
+template <typename Container> void register_session_graph(Container &c) {
+  c.template register_type<scope<unique>, storage<session_payload>>();
+  c.template register_type<scope<unique>, storage<session_consumer>>();
+}
+} // namespace
+
+TEST(resolution_session_test, session_reuses_grown_scratch_between_resolves) {
+  session_payload::addresses.clear();
+  container<> container;
+  register_session_graph(container);
+
+  resolution_session session;
+  EXPECT_EQ(resolution_session::current(), &session);
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+  EXPECT_GE(session.capacity(), sizeof(session_payload));
+  const auto capacity = session.capacity();
+
+  // Keeps the allocator from handing released blocks straight back.
+  auto held = std::make_unique<char[]>(2048);
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+  EXPECT_EQ(session.capacity(), capacity);
+
+  ASSERT_EQ(session_payload::addresses.size(), 3u);
+  EXPECT_EQ(session_payload::addresses[1], session_payload::addresses[2]);
+}
+
+TEST(resolution_session_test, sessions_nest_and_restore_previous_session) {
+  EXPECT_EQ(resolution_session::current(), nullptr);
+  {
+    resolution_session outer;
+    {
+      resolution_session inner;
+      EXPECT_EQ(resolution_session::current(), &inner);
+    }
+    EXPECT_EQ(resolution_session::current(), &outer);
+  }
+  EXPECT_EQ(resolution_session::current(), nullptr);
+}
+
+TEST(resolution_session_test, failed_resolve_rewinds_session_scratch) {
+  session_payload::addresses.clear();
+  container<> container;
+  register_session_graph(container);
+  container.register_type<scope<unique>, storage<session_throwing>>();
+  container.register_type<scope<shared>, storage<session_throwing_consumer>>();
+
+  resolution_session session;
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+  EXPECT_THROW(container.resolve<session_throwing_consumer &>(),
+               std::runtime_error);
+  auto held = std::make_unique<char[]>(2048);
+  EXPECT_EQ(container.resolve<session_consumer>().size, 1024u);
+
+  ASSERT_EQ(session_payload::addresses.size(), 4u);
+  EXPECT_EQ(session_payload::addresses[1], session_payload::addresses[3]);
+}
+
+TEST(resolution_session_test, nested_resolves_share_session_scratch) {
+  session_payload::addresses.clear();
+  container<> inner;
+  register_session_graph(inner);
+
+  container<> outer;
+  outer.register_type<scope<unique>, storage<session_payload>>();
+  outer.register_type<scope<unique>, storage<std::size_t>>(
+      callable([&inner](const session_payload &payload) {
+        return inner.resolve<session_consumer>().size + sizeof(payload.data);
+      }));
+
+  resolution_session session;
+  EXPECT_EQ(outer.resolve<std::size_t>(), 2048u);
+  EXPECT_EQ(outer.resolve<std::size_t>(), 2048u);
+  EXPECT_EQ(outer.resolve<std::size_t>(), 2048u);
+
+  ASSERT_EQ(session_payload::addresses.size(), 6u);
+  EXPECT_NE(session_payload::addresses[2], session_payload::addresses[3]);
+  EXPECT_EQ(session_payload::addresses[2], session_payload::addresses[4]);
+  EXPECT_EQ(session_payload::addresses[3], session_payload::addresses[5]);
+}
+
+TEST(resolution_session_test, resolve_all_rolls_back_inside_session) {
+  session_counted<0>::constructions = 0;
+  session_counted<1>::constructions = 0;
+  container<> container;
+  container.register_type<scope<shared>, storage<session_counted<0>>>();
+  container.register_type<scope<shared>, storage<session_counted<1>>>();
+  container.register_type<scope<shared>, storage<session_throwing>>();
+
+  resolution_session session;
+  EXPECT_THROW((container.resolve_all<session_counted<0> &,
+                                      session_counted<1> &,
+                                      session_throwing &>()),
+               std::runtime_error);
+  container.resolve_all<session_counted<0> &, session_counted<1> &>();
+  EXPECT_EQ(session_counted<0>::constructions, 2);
+  EXPECT_EQ(session_counted<1>::constructions, 2);
+}
+
+TEST(resolution_session_test, factory_rolls_back_nested_resolves_in_session) {
+  session_counted<0>::constructions = 0;
+  session_counted<1>::constructions = 0;
+  container<> container;
+  container.register_type<scope<shared>, storage<session_counted<0>>>();
+  container.register_type<scope<shared>, storage<session_counted<1>>>();
+  container.register_type<scope<unique>, storage<session_throwing_product>>(
+      callable([&container]() -> session_throwing_product {
+        container.resolve<session_counted<0> &>();
+        container.resolve<session_counted<1> &>();
+        throw std::runtime_error("session_throwing_product");
+      }));
+
+  resolution_session session;
+  EXPECT_THROW(container.resolve<session_throwing_product>(),
+               std::runtime_error);
+  container.resolve<session_counted<0> &>();
+  container.resolve<session_counted<1> &>();
+  EXPECT_EQ(session_counted<0>::constructions, 2);
+  EXPECT_EQ(session_counted<1>::constructions, 2);
+}
+} // namespace dingo
@@ -0,0 +1,155 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/runtime/statistics.h>
+#include <dingo/runtime_container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+
+namespace dingo {
+namespace {
+struct statistics_traits : dynamic_container_traits {
+  using statistics_type = collect_statistics;
+};
+
+struct counted_logger {};
+
+struct counted_service {
+  explicit counted_service(counted_logger &) {}
+};
+
+struct counted_failing {
+  counted_failing() { throw std::runtime_error("failure"); }
+};
+
+struct counted_failing_consumer {
+  explicit counted_failing_consumer(counted_failing &) {}
+};
+
+struct counted_failing_root {
+  explicit counted_failing_root(counted_failing_consumer &) {}
+};
+
+struct counted_unregistered {};
+
+struct counted_unique {};
+
+// Resolves its dependency through the container from its constructor, so the
+// failure passes through a nested resolve call.
+struct counted_reentrant {
+  static runtime_container<statistics_traits> *container;
+
+  counted_reentrant() { container->resolve<counted_failing &>(); }
+};
+
+runtime_container<statistics_traits> *counted_reentrant::container = nullptr;
+
+static_assert(std::is_same_v<
+              detail::container_statistics_type_t<dynamic_container_traits>,
+              no_statistics>);
+} // namespace
+
+TEST(statistics_test, reports_bindings_and_memory) {
+  runtime_container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_logger>>();
+  container.register_type<scope<shared>, storage<counted_service>>();
+
+  auto before = container.statistics();
+  EXPECT_EQ(before.bindings, 2u);
+  ASSERT_FALSE(before.lookup_bindings.empty());
+  EXPECT_GE(std::accumulate(before.lookup_bindings.begin(),
+                            before.lookup_bindings.end(), std::size_t(0)),
+            2u);
+  EXPECT_EQ(before.destructors, 0u);
+
+  container.resolve<counted_service &>();
+
+  auto after = container.statistics();
+  EXPECT_EQ(after.bindings, 2u);
+  EXPECT_GT(after.arena_used, before.arena_used);
+  EXPECT_GE(after.arena_reserved, after.arena_used);
+  EXPECT_GE(after.destructors, 2u);
+}
+
+TEST(statistics_test, counts_cache_hits_and_misses) {
+  container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_logger>>();
+
+  container.resolve<counted_logger &>();
+  container.resolve<counted_logger &>();
+  container.resolve<counted_logger &>();
+
+  auto statistics = container.statistics();
+  EXPECT_EQ(statistics.cache_misses, 1u);
+  EXPECT_EQ(statistics.cache_hits, 2u);
+  EXPECT_EQ(statistics.rollbacks, 0u);
+}
+
+TEST(statistics_test, counts_one_transaction_per_batch) {
+  runtime_container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_logger>>();
+  container.register_type<scope<shared>, storage<counted_service>>();
+  container.register_type<scope<unique>, storage<counted_unique>>();
+
+  container.resolve_all<counted_service &, counted_logger &,
+                        counted_unique>();
+  EXPECT_EQ(container.statistics().transactions, 1u);
+
+  container.resolve<counted_logger &>();
+  EXPECT_EQ(container.statistics().transactions, 1u);
+
+  container.resolve_all<counted_service &, counted_logger &,
+                        counted_unique>();
+  EXPECT_EQ(container.statistics().transactions, 2u);
+}
+
+TEST(statistics_test, counts_rollbacks) {
+  runtime_container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_failing>>();
+  container.register_type<scope<unique>, storage<counted_logger>>();
+
+  EXPECT_THROW(container.resolve<counted_failing &>(), std::runtime_error);
+  EXPECT_THROW((container.resolve_all<counted_logger, counted_failing &>()),
+               std::runtime_error);
+  container.resolve<counted_logger>();
+
+  auto statistics = container.statistics();
+  EXPECT_EQ(statistics.rollbacks, 2u);
+  EXPECT_EQ(statistics.destructors, 0u);
+}
+
+TEST(statistics_test, counts_outermost_rollbacks_only) {
+  runtime_container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_failing>>();
+  container.register_type<scope<shared>, storage<counted_failing_consumer>>();
+  container.register_type<scope<shared>, storage<counted_failing_root>>();
+
+  EXPECT_THROW(container.resolve<counted_failing_root &>(),
+               std::runtime_error);
+  EXPECT_EQ(container.statistics().rollbacks, 1u);
+
+  EXPECT_THROW(container.resolve<counted_unregistered &>(),
+               type_not_found_exception);
+  EXPECT_EQ(container.statistics().rollbacks, 2u);
+}
+
+TEST(statistics_test, counts_reentrant_failure_once) {
+  runtime_container<statistics_traits> container;
+  container.register_type<scope<shared>, storage<counted_failing>>();
+  container.register_type<scope<shared>, storage<counted_reentrant>>();
+  counted_reentrant::container = &container;
+
+  EXPECT_THROW(container.resolve<counted_reentrant &>(), std::runtime_error);
+  EXPECT_EQ(container.statistics().rollbacks, 1u);
+}
+} // namespace dingo
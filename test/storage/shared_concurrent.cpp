@@ -0,0 +1,208 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/static_container.h>
+#include <dingo/storage/shared.h>
+#include <dingo/storage/shared_concurrent.h>
+#include <dingo/storage/unique.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace dingo;
+
+namespace {
+struct concurrent_config {
+  concurrent_config() { ++constructions; }
+
+  static std::atomic<int> constructions;
+};
+
+std::atomic<int> concurrent_config::constructions{0};
+
+// Threads arrive from inside the storage before the instance is published;
+// the constructor waits for all of them, so every other thread has entered the
+// storage while the instance is still being constructed.
+struct concurrent_arrivals {
+  void arrive() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++arrived;
+    }
+    arrived_changed.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    arrived_changed.wait(lock, [&] { return arrived == expected; });
+  }
+
+  std::mutex mutex;
+  std::condition_variable arrived_changed;
+  std::size_t arrived = 0;
+  std::size_t expected = 0;
+};
+
+// shared_concurrent storage that reports the threads entering it.
+struct contended_shared_concurrent {
+  static concurrent_arrivals *arrivals;
+};
+
+concurrent_arrivals *contended_shared_concurrent::arrivals = nullptr;
+
+struct concurrent_service_interface {
+  virtual ~concurrent_service_interface() = default;
+};
+
+struct concurrent_service : concurrent_service_interface {
+  explicit concurrent_service(concurrent_config &config_ref)
+      : config(config_ref) {
+    ++constructions;
+    if (contended_shared_concurrent::arrivals != nullptr) {
+      contended_shared_concurrent::arrivals->wait();
+    }
+  }
+
+  concurrent_config &config;
+  static std::atomic<int> constructions;
+};
+
+std::atomic<int> concurrent_service::constructions{0};
+
+struct concurrent_failing_service {
+  explicit concurrent_failing_service(concurrent_config &) {
+    throw std::runtime_error("construction failed");
+  }
+};
+} // namespace
+
+namespace dingo {
+template <typename Type>
+struct storage_materialization_traits<contended_shared_concurrent, Type>
+    : storage_materialization_traits<shared_concurrent, Type> {};
+
+template <typename Type, typename U>
+struct storage_traits<
+    contended_shared_concurrent, Type, U,
+    std::enable_if_t<!std::is_const_v<Type> && !std::is_reference_v<Type>>>
+    : storage_traits<shared_concurrent, Type, U> {};
+
+namespace detail {
+template <typename Type, typename U>
+struct conversions<contended_shared_concurrent, Type, U>
+    : type_storage_traits<contended_shared_concurrent, Type, U> {};
+
+template <typename Type, typename StoredType, typename Factory,
+          typename Conversions>
+class storage<contended_shared_concurrent, Type, StoredType, Factory,
+              Conversions>
+    : public storage<shared_concurrent, Type, StoredType, Factory,
+                     Conversions> {
+  using base_type =
+      storage<shared_concurrent, Type, StoredType, Factory, Conversions>;
+
+public:
+  using base_type::base_type;
+
+  template <typename Context, typename Container>
+  decltype(auto) resolve(construction_scope scope, Context &context,
+                         Container &container) {
+    if (!this->is_resolved() &&
+        contended_shared_concurrent::arrivals != nullptr) {
+      contended_shared_concurrent::arrivals->arrive();
+    }
+    return base_type::resolve(scope, context, container);
+  }
+};
+} // namespace detail
+} // namespace dingo
+
+TEST(shared_concurrent_test, runtime_container_resolves_single_instance) {
+  concurrent_config::constructions = 0;
+  concurrent_service::constructions = 0;
+
+  container<> container;
+  container
+      .register_type<scope<shared_concurrent>, storage<concurrent_config>>();
+  container.register_type<scope<shared_concurrent>,
+                          storage<std::unique_ptr<concurrent_service>>,
+                          interfaces<concurrent_service_interface,
+                                     concurrent_service>>();
+
+  auto &service = container.resolve<concurrent_service &>();
+  EXPECT_EQ(&container.resolve<concurrent_service_interface &>(), &service);
+  EXPECT_EQ(container.resolve<concurrent_service *>(), &service);
+  EXPECT_EQ(&service.config, &container.resolve<concurrent_config &>());
+  EXPECT_EQ(concurrent_config::constructions, 1);
+  EXPECT_EQ(concurrent_service::constructions, 1);
+}
+
+TEST(shared_concurrent_test, failed_construction_is_retried) {
+  concurrent_config::constructions = 0;
+
+  container<> container;
+  container
+      .register_type<scope<shared_concurrent>, storage<concurrent_config>>();
+  container.register_type<scope<shared_concurrent>,
+                          storage<concurrent_failing_service>>();
+
+  EXPECT_THROW(container.resolve<concurrent_failing_service &>(),
+               std::runtime_error);
+  EXPECT_THROW(container.resolve<concurrent_failing_service &>(),
+               std::runtime_error);
+  container.resolve<concurrent_config &>();
+  EXPECT_EQ(concurrent_config::constructions, 3);
+}
+
+TEST(shared_concurrent_test,
+     static_container_constructs_once_under_contention) {
+  concurrent_config::constructions = 0;
+  concurrent_service::constructions = 0;
+
+  using source = bindings<
+      bind<scope<shared_concurrent>, storage<concurrent_config>>,
+      bind<scope<contended_shared_concurrent>, storage<concurrent_service>,
+           interfaces<concurrent_service_interface>>>;
+
+  static_container<source> container;
+
+  constexpr std::size_t thread_count = 8;
+  concurrent_arrivals arrivals;
+  arrivals.expected = thread_count;
+  contended_shared_concurrent::arrivals = &arrivals;
+  std::vector<concurrent_service_interface *> results(thread_count);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&, i] {
+      results[i] = &container.resolve<concurrent_service_interface &>();
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  contended_shared_concurrent::arrivals = nullptr;
+
+  // Every thread found the instance unpublished inside the storage.
+  EXPECT_EQ(arrivals.arrived, thread_count);
+
+  for (auto *result : results) {
+    EXPECT_EQ(result, results.front());
+  }
+  EXPECT_EQ(concurrent_config::constructions, 1);
+  EXPECT_EQ(concurrent_service::constructions, 1);
+}
@@ -0,0 +1,74 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/rtti/canonical_static_provider.h>
+#include <dingo/storage/shared.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+namespace dingo {
+// Named namespace, as the provider rejects types in anonymous namespaces.
+namespace canonical_static_provider_test_types {
+template <int> struct canonical_type {};
+} // namespace canonical_static_provider_test_types
+
+namespace {
+using canonical_rtti = rtti<canonical_static_provider>;
+using canonical_static_provider_test_types::canonical_type;
+
+struct canonical_container_traits : dynamic_container_traits {
+  using rtti_type = canonical_rtti;
+};
+
+struct anonymous_type {};
+
+static_assert(sizeof(canonical_rtti::type_index) == sizeof(uint32_t));
+static_assert(detail::is_canonical_type_name(raw_type_name<int>()));
+static_assert(
+    detail::is_canonical_type_name(raw_type_name<canonical_type<0>>()));
+static_assert(
+    detail::is_canonical_type_name(raw_type_name<void (*)(int)>()));
+static_assert(!detail::is_canonical_type_name(raw_type_name<anonymous_type>()));
+static_assert(!detail::is_canonical_type_name(
+    raw_type_name<canonical_type<0> (*)(anonymous_type)>()));
+
+constexpr auto local_type_name() {
+  struct local_type {};
+  return raw_type_name<local_type>();
+}
+
+static_assert(!detail::is_canonical_type_name(local_type_name()));
+} // namespace
+
+TEST(canonical_static_provider_test, assigns_ids_by_type_name) {
+  const auto first = canonical_rtti::get_type_index<canonical_type<0>>();
+  const auto second = canonical_rtti::get_type_index<canonical_type<1>>();
+
+  EXPECT_EQ(first, canonical_rtti::get_type_index<canonical_type<0>>());
+  EXPECT_FALSE(first == second);
+  EXPECT_FALSE(canonical_rtti::get_type_index<int>() ==
+               canonical_rtti::get_type_index<const int>());
+
+  // A second copy of the name, as interned by another shared library, maps
+  // to the id assigned on first use.
+  const std::string name(raw_type_name<canonical_type<0>>());
+  EXPECT_EQ(detail::interned_type_names().intern(name), first.value());
+}
+
+TEST(canonical_static_provider_test, resolves_through_base_lookup) {
+  container<canonical_container_traits> container;
+  container.register_type<scope<shared>, storage<canonical_type<2>>>();
+  container.register_type<scope<shared>, storage<canonical_type<3>>>();
+
+  EXPECT_NE(static_cast<void *>(&container.resolve<canonical_type<2> &>()),
+            static_cast<void *>(&container.resolve<canonical_type<3> &>()));
+}
+} // namespace dingo
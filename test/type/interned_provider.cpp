@@ -0,0 +1,71 @@
+//
+// This file is part of dingo project <https://github.com/romanpauk/dingo>
+//
+// See LICENSE for license and copyright information
+// SPDX-License-Identifier: MIT
+//
+
+#include <dingo/container.h>
+#include <dingo/rtti/interned_provider.h>
+#include <dingo/storage/shared.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dingo {
+namespace {
+using interned_rtti = rtti<interned_provider>;
+
+template <int> struct interned_type {};
+
+// Interned ids are opt-in; the default traits keep typeid-based ids.
+struct interned_traits : dynamic_container_traits {
+  using rtti_type = interned_rtti;
+};
+
+static_assert(std::is_same_v<dynamic_container_traits::rtti_type,
+                             rtti<typeid_provider>>);
+static_assert(sizeof(interned_rtti::type_index) == sizeof(uint32_t));
+} // namespace
+
+TEST(interned_provider_test, assigns_dense_ids) {
+  const auto first = interned_rtti::get_type_index<interned_type<0>>();
+  const auto second = interned_rtti::get_type_index<interned_type<1>>();
+
+  EXPECT_EQ(first, interned_rtti::get_type_index<interned_type<0>>());
+  EXPECT_FALSE(first == second);
+  EXPECT_LT(first.value(), detail::interned_types().size());
+  EXPECT_LT(second.value(), detail::interned_types().size());
+  EXPECT_FALSE(interned_rtti::get_type_index<int>() ==
+               interned_rtti::get_type_index<int &>());
+}
+
+TEST(interned_provider_test, interns_concurrently) {
+  std::vector<uint32_t> ids(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    threads.emplace_back([&ids, i] {
+      ids[i] = interned_rtti::get_type_index<interned_type<2>>().value();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto id : ids) {
+    EXPECT_EQ(id, ids.front());
+  }
+}
+
+TEST(interned_provider_test, resolves_through_base_lookup) {
+  container<interned_traits> container;
+  container.register_type<scope<shared>, storage<interned_type<3>>>();
+  container.register_type<scope<shared>, storage<interned_type<4>>>();
+
+  EXPECT_NE(static_cast<void *>(&container.resolve<interned_type<3> &>()),
+            static_cast<void *>(&container.resolve<interned_type<4> &>()));
+}
+} // namespace dingo
@@ -19,6 +19,10 @@ namespace {
 struct type_list_a {};
 struct type_list_b {};
 struct type_list_c {};
+template <size_t Index> struct type_list_n {};
+
+template <size_t... Indexes>
+using type_list_n_list = type_list<type_list_n<Indexes % 12>...>;
 
 TEST(type_list_test, meta_utilities) {
   using nested_tuple =
@@ -38,12 +42,34 @@ TEST(type_list_test, meta_utilities) {
   static_assert(!type_list_contains_v<type_list_a, type_list<>>);
   static_assert(type_list_contains_v<type_list_a, nested_list>);
   static_assert(!type_list_contains_v<type_list_c, nested_list>);
+  static_assert(std::is_same_v<type_list_at_t<0, nested_list>, type_list_a>);
+  static_assert(std::is_same_v<type_list_at_t<1, nested_list>,
+                               type_list<type_list_b, type_list_c>>);
+  static_assert(std::is_void_v<type_list_at_t<2, nested_list>>);
+  static_assert(std::is_void_v<type_list_at_t<0, type_list<>>>);
+  static_assert(
+      type_list_index_of_v<type_list_b,
+                           type_list<type_list_a, type_list_b, type_list_b>> ==
+      1);
+  static_assert(type_list_index_of_v<type_list_c, nested_list> == 2);
+  static_assert(type_list_index_of_v<type_list_a, type_list<>> == 0);
   static_assert(std::is_same_v<type_list_unique_t<type_list<>>, type_list<>>);
   static_assert(
       std::is_same_v<
           type_list_unique_t<type_list<type_list_a, type_list_b, type_list_a,
                                        type_list_c, type_list_b>>,
           type_list<type_list_a, type_list_b, type_list_c>>);
+  // Longer lists take the hashed path.
+  static_assert(
+      std::is_same_v<type_list_unique_t<type_list_n_list<
+                         0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                         16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28>>,
+                     type_list_n_list<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11>>);
+  static_assert(
+      std::is_same_v<type_list_unique_t<type_list_n_list<
+                         11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 23, 22, 21, 20,
+                         19, 18, 17, 16, 15, 14, 13, 12>>,
+                     type_list_n_list<11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0>>);
   static_assert(
       std::is_same_v<type_list_merge_t<type_list<type_list_a, type_list_b>,
                                        type_list<type_list_b, type_list_c>>,